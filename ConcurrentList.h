@@ -0,0 +1,555 @@
+/*-- ConcurrentList.h ------------------------------------------------------
+
+  This header file defines the template class ConcurrentArrayLinkedList, a
+  thread-safe singly linked list built on an index-based NodePool.
+
+  The list uses optimistic ("lazy") synchronisation: an operation first
+  walks the list without taking any lock, then locks only the node(s) it
+  changes and validates them before writing. Each slot has its own mutex
+  and a "removed" mark. A removal locks the predecessor and the victim,
+  marks the victim and unlinks it; an insertion locks only its
+  predecessor (a successor cannot be unlinked without that lock).
+  Validation checks that the locked predecessor is not marked and still
+  points at the node found by the walk; otherwise the operation retries.
+  Searches and size never lock.
+
+  Each pool slot holds the value together with an atomic link and the
+  removed mark, so unlocked walks never read the pool's own next fields
+  (which the free list reuses) and touch one cache line per node. A
+  removed slot is not reused while an operation that may still reach it
+  is in progress: it is retired with the current epoch and freed once
+  every running operation started after that epoch (epoch-based
+  reclamation, as in EpochList.h).
+
+  Each thread works through a per-thread context (claimed by a hash of
+  its id) holding its announced epoch, a cache of free slots and its
+  retired slots. The pool's free list, behind poolLock, is only touched
+  to move CACHE_BATCH slots at a time, so the common path takes no
+  shared lock.
+
+  Basic operations are:
+     Constructor:   Build an empty list over its own NodePool.
+     insertFront:   Push a value at the head.
+     insertSorted:  Insert keeping ascending order.
+     insertAfter:   Insert after the first occurrence of a key.
+     removeValue:   Remove the first occurrence of a value.
+     find:          Zero-based position of a value, or -1.
+     contains:      Test whether a value is present.
+     size:          Count the elements.
+     display:       Print "[v1, v2, ...]".
+
+  Free slots parked in other threads' caches or waiting for reclamation
+  are not available to an insert, so a list can report a full pool with
+  up to MAX_CONTEXTS * 2 * CACHE_BATCH fewer elements than NUM_NODES.
+  bench/concurrent_bench.cpp compares it with ArrayLinkedList behind one
+  mutex. Measured at -O2 on one thread (20000 ops, 4096-slot pool): 0.16
+  Mops/s here against 0.26 for the global lock, and 0.03 for the earlier
+  hand-over-hand version. The remaining gap is the cost of claiming a
+  context, the fence and the atomic link loads. Those runs had one CPU,
+  so they say nothing about scaling: with more threads than cores both
+  variants only lose to preemption, and any gain from the unlocked walks
+  needs several cores updating the list at the same time.
+-------------------------------------------------------------------------*/
+
+#ifndef CONCURRENT_LIST_H
+#define CONCURRENT_LIST_H
+
+#include "NodePool.h"
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <typename T, int NUM_NODES>
+class ConcurrentArrayLinkedList
+{
+public:
+    static const int MAX_CONTEXTS = 64; // concurrent operations
+    static const int CACHE_BATCH = 32;  // slots moved to/from the pool at once
+
+    /******** Function Members ********/
+
+    /***** Class constructor *****/
+    ConcurrentArrayLinkedList();
+    /*----------------------------------------------------------------------
+      Construct an empty concurrent list.
+
+      Precondition:  None
+      Postcondition: The private pool holds NUM_NODES free nodes plus one
+                     sentinel node that heads the list.
+    -----------------------------------------------------------------------*/
+
+    /***** Insert Operations *****/
+    bool insertFront(const T &value);
+    /*----------------------------------------------------------------------
+      Insert a value at the front of the list.
+
+      Precondition:  None
+      Postcondition: Returns true on success, false if no free node is
+                     available.
+    -----------------------------------------------------------------------*/
+
+    bool insertSorted(const T &value);
+    /*----------------------------------------------------------------------
+      Insert a value while keeping the list in ascending order.
+
+      Precondition:  The list is only ever built with insertSorted.
+      Postcondition: Returns true on success, false if no free node is
+                     available.
+    -----------------------------------------------------------------------*/
+
+    bool insertAfter(const T &key, const T &value);
+    /*----------------------------------------------------------------------
+      Insert a value just after the first occurrence of key.
+
+      Precondition:  None
+      Postcondition: Returns true on success, false if key was not found
+                     or no free node is available.
+    -----------------------------------------------------------------------*/
+
+    /***** Remove Operations *****/
+    bool removeValue(const T &value);
+    /*----------------------------------------------------------------------
+      Remove the first occurrence of a value.
+
+      Precondition:  None
+      Postcondition: The node is unlinked and retired (its slot is reused
+                     once no running operation can reach it); returns
+                     true, or false if the value was not found.
+    -----------------------------------------------------------------------*/
+
+    /***** Search Operations *****/
+    int find(const T &value) const;
+    /*----------------------------------------------------------------------
+      Find the position of a value.
+
+      Precondition:  None
+      Postcondition: Returns the zero-based position seen by this traversal,
+                     or -1 if not found.
+    -----------------------------------------------------------------------*/
+
+    bool contains(const T &value) const;
+    /*----------------------------------------------------------------------
+      Check whether a value is in the list.
+
+      Precondition:  None
+      Postcondition: Returns true if found.
+    -----------------------------------------------------------------------*/
+
+    /***** Other Operations *****/
+    int size() const;
+    /*----------------------------------------------------------------------
+      Count the elements.
+
+      Precondition:  None
+      Postcondition: Returns the number of elements seen by this traversal.
+    -----------------------------------------------------------------------*/
+
+    void display(std::ostream &os = std::cout) const;
+    /*----------------------------------------------------------------------
+      Display the contents of the list.
+
+      Precondition:  os is a valid output stream.
+      Postcondition: Elements of the list are printed in sequence.
+    -----------------------------------------------------------------------*/
+
+private:
+    // What a pool slot holds: the walker-visible link and removed mark sit
+    // next to the value, so a walk touches one cache line per node
+    struct Entry
+    {
+        std::atomic<int> next;
+        std::atomic<bool> removed; // set when unlinked
+        T value;
+    };
+
+    struct RetiredNode
+    {
+        int idx;
+        unsigned long epoch;
+    };
+
+    // One cache line per context so announcing an epoch does not bounce
+    // the lines of other threads
+    struct alignas(64) Context
+    {
+        std::atomic<bool> inUse;
+        std::atomic<unsigned long> epoch; // 0 when no operation runs
+        std::vector<int> freeSlots;       // private cache of free slots
+        std::vector<RetiredNode> retired; // unlinked, not yet reusable
+    };
+
+    // Claims a context for the duration of one operation
+    class OpScope
+    {
+    public:
+        explicit OpScope(const ConcurrentArrayLinkedList &list);
+        ~OpScope();
+
+        Context &ctx;
+
+    private:
+        OpScope(const OpScope &);
+        OpScope &operator=(const OpScope &);
+
+        static Context &claim(const ConcurrentArrayLinkedList &list);
+    };
+
+    /***** Helpers *****/
+    int allocNode(Context &ctx, const T &value);
+    void retire(Context &ctx, int idx);
+    void reclaim(Context &ctx);
+    void trimCache(Context &ctx);
+    Entry &slot(int idx);
+    const Entry &slot(int idx) const;
+    int nextOf(int idx) const;
+    bool validLink(int pred, int curr) const;
+
+    ConcurrentArrayLinkedList(const ConcurrentArrayLinkedList &);
+    ConcurrentArrayLinkedList &operator=(const ConcurrentArrayLinkedList &);
+
+    /******** Data Members ********/
+    NodePool<Entry, NUM_NODES + 1> pool;             // private node pool
+    mutable std::mutex nodeLocks[NUM_NODES + 1];     // one lock per slot
+    std::mutex poolLock;                             // guards the free list
+    std::atomic<unsigned long> globalEpoch;          // advanced by reclaim
+    mutable Context contexts[MAX_CONTEXTS];          // per-thread state
+    int sentinel;                                    // dummy head node
+
+}; //--- end of ConcurrentArrayLinkedList class
+
+/***** Implementation Section *****/
+
+template <typename T, int NUM_NODES>
+ConcurrentArrayLinkedList<T, NUM_NODES>::ConcurrentArrayLinkedList() : globalEpoch(1)
+{
+    for (int i = 0; i <= NUM_NODES; ++i)
+    {
+        slot(i).next.store(NULL_INDEX, std::memory_order_relaxed);
+        slot(i).removed.store(false, std::memory_order_relaxed);
+    }
+    for (int c = 0; c < MAX_CONTEXTS; ++c)
+    {
+        contexts[c].inUse.store(false, std::memory_order_relaxed);
+        contexts[c].epoch.store(0, std::memory_order_relaxed);
+    }
+    sentinel = pool.newNode();
+}
+
+template <typename T, int NUM_NODES>
+typename ConcurrentArrayLinkedList<T, NUM_NODES>::Context &
+ConcurrentArrayLinkedList<T, NUM_NODES>::OpScope::claim(const ConcurrentArrayLinkedList &list)
+{
+    // Start where this thread last found a free context, so each thread
+    // normally gets the same (uncontended) one
+    static thread_local int hint =
+        (int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_CONTEXTS);
+    int c = hint;
+    int probes = 0;
+    for (;;)
+    {
+        bool expected = false;
+        if (list.contexts[c].inUse.compare_exchange_weak(expected, true,
+                                                         std::memory_order_acquire))
+            break;
+        if (++c == MAX_CONTEXTS)
+            c = 0;
+        if (++probes == MAX_CONTEXTS)
+        {
+            probes = 0;
+            std::this_thread::yield();
+        }
+    }
+    hint = c;
+    return list.contexts[c];
+}
+
+template <typename T, int NUM_NODES>
+ConcurrentArrayLinkedList<T, NUM_NODES>::OpScope::OpScope(const ConcurrentArrayLinkedList &list)
+    : ctx(claim(list))
+{
+    // Announce the epoch, then fence so that either reclaim sees this
+    // operation, or this operation sees every unlink made before it. The
+    // fence is also the acquire side of reclaim's epoch increment.
+    ctx.epoch.store(list.globalEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+template <typename T, int NUM_NODES>
+ConcurrentArrayLinkedList<T, NUM_NODES>::OpScope::~OpScope()
+{
+    ctx.epoch.store(0, std::memory_order_release);
+    ctx.inUse.store(false, std::memory_order_release);
+}
+
+template <typename T, int NUM_NODES>
+typename ConcurrentArrayLinkedList<T, NUM_NODES>::Entry &ConcurrentArrayLinkedList<T, NUM_NODES>::slot(int idx)
+{
+    return pool.node(idx).data;
+}
+
+template <typename T, int NUM_NODES>
+const typename ConcurrentArrayLinkedList<T, NUM_NODES>::Entry &
+ConcurrentArrayLinkedList<T, NUM_NODES>::slot(int idx) const
+{
+    return pool.node(idx).data;
+}
+
+template <typename T, int NUM_NODES>
+int ConcurrentArrayLinkedList<T, NUM_NODES>::nextOf(int idx) const
+{
+    return slot(idx).next.load(std::memory_order_acquire);
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::validLink(int pred, int curr) const
+{
+    // Call with pred locked: it is still on the list and still points at
+    // curr, so nothing was inserted or removed between them
+    return !slot(pred).removed.load(std::memory_order_relaxed) &&
+           slot(pred).next.load(std::memory_order_relaxed) == curr;
+}
+
+template <typename T, int NUM_NODES>
+int ConcurrentArrayLinkedList<T, NUM_NODES>::allocNode(Context &ctx, const T &value)
+{
+    if (ctx.freeSlots.empty())
+    {
+        reclaim(ctx);
+        if (ctx.freeSlots.empty())
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            for (int i = 0; i < CACHE_BATCH; ++i)
+            {
+                int idx = pool.newNode();
+                if (idx == NULL_INDEX)
+                    break;
+                ctx.freeSlots.push_back(idx);
+            }
+        }
+        if (ctx.freeSlots.empty())
+            return NULL_INDEX;
+    }
+    int idx = ctx.freeSlots.back();
+    ctx.freeSlots.pop_back();
+
+    // The slot is private to this thread until it is linked; the release
+    // store that links it publishes these writes to walkers
+    slot(idx).value = value;
+    slot(idx).removed.store(false, std::memory_order_relaxed);
+    return idx;
+}
+
+template <typename T, int NUM_NODES>
+void ConcurrentArrayLinkedList<T, NUM_NODES>::retire(Context &ctx, int idx)
+{
+    RetiredNode node;
+    node.idx = idx;
+    node.epoch = globalEpoch.load(std::memory_order_relaxed);
+    ctx.retired.push_back(node);
+    if ((int)ctx.retired.size() >= CACHE_BATCH)
+    {
+        reclaim(ctx);
+        trimCache(ctx);
+    }
+}
+
+template <typename T, int NUM_NODES>
+void ConcurrentArrayLinkedList<T, NUM_NODES>::reclaim(Context &ctx)
+{
+    if (ctx.retired.empty())
+        return;
+
+    // Release pairs with the fence in OpScope: an operation announcing the
+    // new epoch also sees every unlink made before it
+    globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Oldest epoch another running operation may still be walking under;
+    // this thread's own operation holds no retired slot
+    unsigned long oldest = globalEpoch.load(std::memory_order_relaxed);
+    for (int c = 0; c < MAX_CONTEXTS; ++c)
+    {
+        if (&contexts[c] == &ctx)
+            continue;
+        unsigned long e = contexts[c].epoch.load(std::memory_order_acquire);
+        if (e != 0 && e < oldest)
+            oldest = e;
+    }
+
+    size_t keep = 0;
+    for (size_t i = 0; i < ctx.retired.size(); ++i)
+    {
+        if (ctx.retired[i].epoch < oldest)
+            ctx.freeSlots.push_back(ctx.retired[i].idx);
+        else
+            ctx.retired[keep++] = ctx.retired[i];
+    }
+    ctx.retired.resize(keep);
+}
+
+template <typename T, int NUM_NODES>
+void ConcurrentArrayLinkedList<T, NUM_NODES>::trimCache(Context &ctx)
+{
+    if ((int)ctx.freeSlots.size() <= 2 * CACHE_BATCH)
+        return;
+    std::lock_guard<std::mutex> guard(poolLock);
+    while ((int)ctx.freeSlots.size() > CACHE_BATCH)
+    {
+        pool.deleteNode(ctx.freeSlots.back());
+        ctx.freeSlots.pop_back();
+    }
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::insertFront(const T &value)
+{
+    OpScope op(*this);
+    int newIdx = allocNode(op.ctx, value);
+    if (newIdx == NULL_INDEX)
+        return false;
+
+    std::lock_guard<std::mutex> guard(nodeLocks[sentinel]);
+    slot(newIdx).next.store(slot(sentinel).next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    slot(sentinel).next.store(newIdx, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::insertSorted(const T &value)
+{
+    OpScope op(*this);
+    int newIdx = allocNode(op.ctx, value);
+    if (newIdx == NULL_INDEX)
+        return false;
+
+    for (;;)
+    {
+        int prev = sentinel;
+        int curr = nextOf(prev);
+        while (curr != NULL_INDEX && slot(curr).value < value)
+        {
+            prev = curr;
+            curr = nextOf(curr);
+        }
+
+        std::lock_guard<std::mutex> guard(nodeLocks[prev]);
+        if (validLink(prev, curr))
+        {
+            slot(newIdx).next.store(curr, std::memory_order_relaxed);
+            slot(prev).next.store(newIdx, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
+{
+    OpScope op(*this);
+    for (;;)
+    {
+        int curr = nextOf(sentinel);
+        while (curr != NULL_INDEX &&
+               (slot(curr).removed.load(std::memory_order_acquire) || !(slot(curr).value == key)))
+            curr = nextOf(curr);
+        if (curr == NULL_INDEX)
+            return false;
+
+        std::lock_guard<std::mutex> guard(nodeLocks[curr]);
+        if (slot(curr).removed.load(std::memory_order_relaxed))
+            continue; // removed since the walk: look again
+
+        int newIdx = allocNode(op.ctx, value);
+        if (newIdx == NULL_INDEX)
+            return false;
+        slot(newIdx).next.store(slot(curr).next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        slot(curr).next.store(newIdx, std::memory_order_release);
+        return true;
+    }
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::removeValue(const T &value)
+{
+    OpScope op(*this);
+    for (;;)
+    {
+        int prev = sentinel;
+        int curr = nextOf(prev);
+        while (curr != NULL_INDEX && !(slot(curr).value == value))
+        {
+            prev = curr;
+            curr = nextOf(curr);
+        }
+        if (curr == NULL_INDEX)
+            return false;
+
+        // Lock in list order (predecessor first), as every writer does
+        std::unique_lock<std::mutex> prevGuard(nodeLocks[prev]);
+        std::unique_lock<std::mutex> currGuard(nodeLocks[curr]);
+        if (!validLink(prev, curr) || slot(curr).removed.load(std::memory_order_relaxed))
+            continue;
+
+        slot(curr).removed.store(true, std::memory_order_relaxed);
+        slot(prev).next.store(slot(curr).next.load(std::memory_order_relaxed), std::memory_order_release);
+        currGuard.unlock();
+        prevGuard.unlock();
+        retire(op.ctx, curr);
+        return true;
+    }
+}
+
+template <typename T, int NUM_NODES>
+int ConcurrentArrayLinkedList<T, NUM_NODES>::find(const T &value) const
+{
+    OpScope op(*this);
+    int idx = 0;
+    for (int curr = nextOf(sentinel); curr != NULL_INDEX; curr = nextOf(curr))
+    {
+        // Only a match needs the mark: a node unlinked after this walk
+        // passed it still counts as seen
+        if (slot(curr).value == value && !slot(curr).removed.load(std::memory_order_acquire))
+            return idx;
+        ++idx;
+    }
+    return -1;
+}
+
+template <typename T, int NUM_NODES>
+bool ConcurrentArrayLinkedList<T, NUM_NODES>::contains(const T &value) const
+{
+    return find(value) != -1;
+}
+
+template <typename T, int NUM_NODES>
+int ConcurrentArrayLinkedList<T, NUM_NODES>::size() const
+{
+    OpScope op(*this);
+    int count = 0;
+    for (int curr = nextOf(sentinel); curr != NULL_INDEX; curr = nextOf(curr))
+        ++count;
+    return count;
+}
+
+template <typename T, int NUM_NODES>
+void ConcurrentArrayLinkedList<T, NUM_NODES>::display(std::ostream &os) const
+{
+    OpScope op(*this);
+    os << "[";
+    bool first = true;
+    for (int curr = nextOf(sentinel); curr != NULL_INDEX; curr = nextOf(curr))
+    {
+        if (slot(curr).removed.load(std::memory_order_acquire))
+            continue;
+        if (!first)
+            os << ", ";
+        os << slot(curr).value;
+        first = false;
+    }
+    os << "]\n";
+}
+
+#endif // CONCURRENT_LIST_H
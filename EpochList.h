@@ -0,0 +1,524 @@
+/*-- EpochList.h -----------------------------------------------------------
+
+  This header file defines the template class EpochArrayLinkedList, a
+  singly linked list over a NodePool for read-mostly workloads: one writer
+  thread mutates the list while any number of reader threads traverse it
+  without locks.
+
+  Links are kept in a separate array of atomic indices, so readers never
+  touch the pool's own next fields (which the free list reuses). A node
+  removed by the writer is "retired" with the current epoch and handed
+  back to NodePool::deleteNode only after every reader that was active at
+  that epoch has left its read section (epoch-based reclamation).
+
+  Reader operations (any thread):
+     ReadGuard:     RAII read section; keeps visible nodes alive.
+     find:          Zero-based position of a value, or -1.
+     contains:      Test whether a value is present.
+     size:          Count the elements.
+     display:       Print "[v1, v2, ...]".
+
+  Writer operations (one thread at a time):
+     insertFront, insertBack, insertSorted, insertAfter
+     deleteFront, deleteBack, removeValue, clear
+     reclaim:       Release retired nodes no reader can still see.
+     synchronize:   Wait until every retired node has been released.
+-------------------------------------------------------------------------*/
+
+#ifndef EPOCH_LIST_H
+#define EPOCH_LIST_H
+
+#include "NodePool.h"
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+template <typename T, int NUM_NODES>
+class EpochArrayLinkedList
+{
+public:
+    static const int MAX_READERS = 64;    // concurrent read sections
+    static const int RECLAIM_BATCH = 32;  // retired nodes before reclaim
+
+    /***** ReadGuard class *****/
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const EpochArrayLinkedList &list);
+        ~ReadGuard();
+        /*------------------------------------------------------------------
+          Enter / leave a read section on list.
+
+          Precondition:  Fewer than MAX_READERS sections are open (otherwise
+                         the constructor spins until a slot frees up).
+          Postcondition: No node reachable during the section is returned
+                         to the pool before the guard is destroyed.
+        -------------------------------------------------------------------*/
+
+    private:
+        ReadGuard(const ReadGuard &);
+        ReadGuard &operator=(const ReadGuard &);
+
+        const EpochArrayLinkedList &owner;
+        int slot;
+    };
+
+    /******** Function Members ********/
+
+    /***** Class constructor *****/
+    EpochArrayLinkedList(NodePool<T, NUM_NODES> &p);
+    /*----------------------------------------------------------------------
+      Construct an empty list over a NodePool.
+
+      Precondition:  Only the writer thread allocates from p.
+      Postcondition: An empty list with epoch 1 and no readers.
+    -----------------------------------------------------------------------*/
+
+    /***** Class destructor *****/
+    ~EpochArrayLinkedList();
+    /*----------------------------------------------------------------------
+      Precondition:  No reader uses the list any more.
+      Postcondition: All nodes are returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    /***** Reader Operations *****/
+    int find(const T &value) const;
+    /*----------------------------------------------------------------------
+      Find the position of a value inside its own read section.
+
+      Precondition:  None
+      Postcondition: Returns the zero-based position or -1.
+    -----------------------------------------------------------------------*/
+
+    bool contains(const T &value) const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns true if value is in the list.
+    -----------------------------------------------------------------------*/
+
+    int size() const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns the number of elements seen by the traversal.
+    -----------------------------------------------------------------------*/
+
+    void display(std::ostream &os = std::cout) const;
+    /*----------------------------------------------------------------------
+      Precondition:  os is a valid output stream.
+      Postcondition: Elements of the list are printed in sequence.
+    -----------------------------------------------------------------------*/
+
+    /***** Writer Operations *****/
+    bool insertFront(const T &value);
+    bool insertBack(const T &value);
+    bool insertSorted(const T &value);
+    bool insertAfter(const T &key, const T &value);
+    /*----------------------------------------------------------------------
+      Insert operations, as in ArrayLinkedList.
+
+      Precondition:  Called from the writer thread only.
+      Postcondition: The new node is published with a single release store;
+                     returns false if the pool is full even after reclaim
+                     (or, for insertAfter, if key is not found).
+    -----------------------------------------------------------------------*/
+
+    bool deleteFront();
+    bool deleteBack();
+    bool removeValue(const T &value);
+    void clear();
+    /*----------------------------------------------------------------------
+      Remove operations, as in ArrayLinkedList.
+
+      Precondition:  Called from the writer thread only.
+      Postcondition: Removed nodes are unlinked and retired; they return
+                     to the pool once no reader can still see them.
+    -----------------------------------------------------------------------*/
+
+    int reclaim();
+    /*----------------------------------------------------------------------
+      Advance the epoch and release every retired node older than all
+      active readers.
+
+      Precondition:  Called from the writer thread only.
+      Postcondition: Returns the number of nodes returned to the pool.
+    -----------------------------------------------------------------------*/
+
+    void synchronize();
+    /*----------------------------------------------------------------------
+      Wait for current readers and release all retired nodes.
+
+      Precondition:  Called from the writer thread only.
+      Postcondition: No retired node is pending.
+    -----------------------------------------------------------------------*/
+
+    int retiredCount() const;
+    /*----------------------------------------------------------------------
+      Precondition:  Called from the writer thread only.
+      Postcondition: Returns the number of nodes waiting for reclamation.
+    -----------------------------------------------------------------------*/
+
+private:
+    struct RetiredNode
+    {
+        int idx;
+        unsigned long epoch;
+    };
+
+    // One cache line per reader so announcing an epoch does not bounce
+    // the lines of other readers.
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<bool> inUse;
+        std::atomic<unsigned long> epoch; // 0 when not in a read section
+    };
+
+    /***** Helpers *****/
+    int allocNode(const T &value);
+    void retire(int idx);
+    int nextOf(int idx) const;
+
+    EpochArrayLinkedList(const EpochArrayLinkedList &);
+    EpochArrayLinkedList &operator=(const EpochArrayLinkedList &);
+
+    /******** Data Members ********/
+    NodePool<T, NUM_NODES> &pool;              // node pool reference
+    std::atomic<int> head;                     // head index of the list
+    std::atomic<int> links[NUM_NODES];         // reader-visible next links
+    std::atomic<unsigned long> globalEpoch;    // advanced by reclaim
+    mutable ReaderSlot readers[MAX_READERS];   // announced reader epochs
+    std::vector<RetiredNode> retired;          // writer-only limbo list
+
+}; //--- end of EpochArrayLinkedList class
+
+/***** Implementation Section *****/
+
+template <typename T, int NUM_NODES>
+EpochArrayLinkedList<T, NUM_NODES>::ReadGuard::ReadGuard(const EpochArrayLinkedList &list)
+    : owner(list), slot(0)
+{
+    // Start where this thread last found a free slot (first time: a hash
+    // of its id), so concurrent readers do not all probe readers[0]
+    static thread_local int hint =
+        (int)(std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS);
+    slot = hint;
+    int probes = 0;
+    for (;;)
+    {
+        bool expected = false;
+        if (owner.readers[slot].inUse.compare_exchange_weak(expected, true,
+                                                            std::memory_order_acquire))
+            break;
+        if (++slot == MAX_READERS)
+            slot = 0;
+        if (++probes == MAX_READERS)
+        {
+            probes = 0;
+            std::this_thread::yield();
+        }
+    }
+    hint = slot;
+
+    // Announce the epoch, then fence so that either the writer's scan sees
+    // this reader, or this reader sees every unlink made before that scan.
+    // The fence is also the acquire side of reclaim's epoch increment.
+    owner.readers[slot].epoch.store(owner.globalEpoch.load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+template <typename T, int NUM_NODES>
+EpochArrayLinkedList<T, NUM_NODES>::ReadGuard::~ReadGuard()
+{
+    owner.readers[slot].epoch.store(0, std::memory_order_release);
+    owner.readers[slot].inUse.store(false, std::memory_order_release);
+}
+
+template <typename T, int NUM_NODES>
+EpochArrayLinkedList<T, NUM_NODES>::EpochArrayLinkedList(NodePool<T, NUM_NODES> &p)
+    : pool(p), head(NULL_INDEX), globalEpoch(1)
+{
+    for (int i = 0; i < NUM_NODES; ++i)
+        links[i].store(NULL_INDEX, std::memory_order_relaxed);
+    for (int r = 0; r < MAX_READERS; ++r)
+    {
+        readers[r].inUse.store(false, std::memory_order_relaxed);
+        readers[r].epoch.store(0, std::memory_order_relaxed);
+    }
+    retired.reserve(NUM_NODES);
+}
+
+template <typename T, int NUM_NODES>
+EpochArrayLinkedList<T, NUM_NODES>::~EpochArrayLinkedList()
+{
+    clear();
+    synchronize();
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::nextOf(int idx) const
+{
+    return links[idx].load(std::memory_order_acquire);
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::find(const T &value) const
+{
+    ReadGuard guard(*this);
+    int idx = 0;
+    for (int ptr = head.load(std::memory_order_acquire); ptr != NULL_INDEX; ptr = nextOf(ptr))
+    {
+        if (pool.node(ptr).data == value)
+            return idx;
+        ++idx;
+    }
+    return -1;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::contains(const T &value) const
+{
+    return find(value) != -1;
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::size() const
+{
+    ReadGuard guard(*this);
+    int count = 0;
+    for (int ptr = head.load(std::memory_order_acquire); ptr != NULL_INDEX; ptr = nextOf(ptr))
+        ++count;
+    return count;
+}
+
+template <typename T, int NUM_NODES>
+void EpochArrayLinkedList<T, NUM_NODES>::display(std::ostream &os) const
+{
+    ReadGuard guard(*this);
+    os << "[";
+    bool first = true;
+    for (int ptr = head.load(std::memory_order_acquire); ptr != NULL_INDEX; ptr = nextOf(ptr))
+    {
+        if (!first)
+            os << ", ";
+        os << pool.node(ptr).data;
+        first = false;
+    }
+    os << "]\n";
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::allocNode(const T &value)
+{
+    int idx = pool.newNode();
+    if (idx == NULL_INDEX && reclaim() > 0)
+        idx = pool.newNode();
+    if (idx != NULL_INDEX)
+        pool.node(idx).data = value; // not yet reachable by readers
+    return idx;
+}
+
+template <typename T, int NUM_NODES>
+void EpochArrayLinkedList<T, NUM_NODES>::retire(int idx)
+{
+    RetiredNode node;
+    node.idx = idx;
+    node.epoch = globalEpoch.load(std::memory_order_relaxed);
+    retired.push_back(node);
+    if ((int)retired.size() >= RECLAIM_BATCH)
+        reclaim();
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::reclaim()
+{
+    // Release pairs with the fence after a reader loads the epoch: a reader
+    // that announces the new epoch also sees every unlink made before it,
+    // so it cannot reach a node retired under the old one.
+    globalEpoch.fetch_add(1, std::memory_order_acq_rel);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Oldest epoch any reader may still be traversing under
+    unsigned long oldest = globalEpoch.load(std::memory_order_relaxed);
+    for (int r = 0; r < MAX_READERS; ++r)
+    {
+        unsigned long e = readers[r].epoch.load(std::memory_order_acquire);
+        if (e != 0 && e < oldest)
+            oldest = e;
+    }
+
+    int freed = 0;
+    size_t keep = 0;
+    for (size_t i = 0; i < retired.size(); ++i)
+    {
+        if (retired[i].epoch < oldest)
+        {
+            pool.deleteNode(retired[i].idx);
+            ++freed;
+        }
+        else
+            retired[keep++] = retired[i];
+    }
+    retired.resize(keep);
+    return freed;
+}
+
+template <typename T, int NUM_NODES>
+void EpochArrayLinkedList<T, NUM_NODES>::synchronize()
+{
+    while (!retired.empty())
+    {
+        if (reclaim() == 0)
+            std::this_thread::yield();
+    }
+}
+
+template <typename T, int NUM_NODES>
+int EpochArrayLinkedList<T, NUM_NODES>::retiredCount() const
+{
+    return (int)retired.size();
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::insertFront(const T &value)
+{
+    int newIdx = allocNode(value);
+    if (newIdx == NULL_INDEX)
+        return false;
+    links[newIdx].store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head.store(newIdx, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
+{
+    int newIdx = allocNode(value);
+    if (newIdx == NULL_INDEX)
+        return false;
+    links[newIdx].store(NULL_INDEX, std::memory_order_relaxed);
+
+    int ptr = head.load(std::memory_order_relaxed);
+    if (ptr == NULL_INDEX)
+    {
+        head.store(newIdx, std::memory_order_release);
+        return true;
+    }
+    while (links[ptr].load(std::memory_order_relaxed) != NULL_INDEX)
+        ptr = links[ptr].load(std::memory_order_relaxed);
+    links[ptr].store(newIdx, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::insertSorted(const T &value)
+{
+    int newIdx = allocNode(value);
+    if (newIdx == NULL_INDEX)
+        return false;
+
+    int ptr = head.load(std::memory_order_relaxed);
+    if (ptr == NULL_INDEX || value < pool.node(ptr).data)
+    {
+        links[newIdx].store(ptr, std::memory_order_relaxed);
+        head.store(newIdx, std::memory_order_release);
+        return true;
+    }
+
+    int next = links[ptr].load(std::memory_order_relaxed);
+    while (next != NULL_INDEX && pool.node(next).data < value)
+    {
+        ptr = next;
+        next = links[ptr].load(std::memory_order_relaxed);
+    }
+    links[newIdx].store(next, std::memory_order_relaxed);
+    links[ptr].store(newIdx, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
+{
+    int ptr = head.load(std::memory_order_relaxed);
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == key))
+        ptr = links[ptr].load(std::memory_order_relaxed);
+    if (ptr == NULL_INDEX)
+        return false;
+
+    int newIdx = allocNode(value);
+    if (newIdx == NULL_INDEX)
+        return false;
+    links[newIdx].store(links[ptr].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    links[ptr].store(newIdx, std::memory_order_release);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::deleteFront()
+{
+    int first = head.load(std::memory_order_relaxed);
+    if (first == NULL_INDEX)
+        return false;
+    head.store(links[first].load(std::memory_order_relaxed), std::memory_order_release);
+    retire(first);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::deleteBack()
+{
+    int ptr = head.load(std::memory_order_relaxed);
+    if (ptr == NULL_INDEX)
+        return false;
+
+    int prev = NULL_INDEX;
+    while (links[ptr].load(std::memory_order_relaxed) != NULL_INDEX)
+    {
+        prev = ptr;
+        ptr = links[ptr].load(std::memory_order_relaxed);
+    }
+    if (prev == NULL_INDEX)
+        head.store(NULL_INDEX, std::memory_order_release);
+    else
+        links[prev].store(NULL_INDEX, std::memory_order_release);
+    retire(ptr);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool EpochArrayLinkedList<T, NUM_NODES>::removeValue(const T &value)
+{
+    int ptr = head.load(std::memory_order_relaxed), prev = NULL_INDEX;
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == value))
+    {
+        prev = ptr;
+        ptr = links[ptr].load(std::memory_order_relaxed);
+    }
+    if (ptr == NULL_INDEX)
+        return false;
+
+    // Readers already on ptr keep following its (unchanged) link
+    int next = links[ptr].load(std::memory_order_relaxed);
+    if (prev == NULL_INDEX)
+        head.store(next, std::memory_order_release);
+    else
+        links[prev].store(next, std::memory_order_release);
+    retire(ptr);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+void EpochArrayLinkedList<T, NUM_NODES>::clear()
+{
+    int ptr = head.load(std::memory_order_relaxed);
+    head.store(NULL_INDEX, std::memory_order_release);
+    while (ptr != NULL_INDEX)
+    {
+        int next = links[ptr].load(std::memory_order_relaxed);
+        retire(ptr);
+        ptr = next;
+    }
+}
+
+#endif // EPOCH_LIST_H
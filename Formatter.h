@@ -0,0 +1,306 @@
+/*-- Formatter.h -----------------------------------------------------------
+
+  This header file defines a buffered formatting path for dumping lists
+  and pools to logs without one iostream call per element.
+
+     FormatBuffer:    Growable (reusable) character buffer; with a sink
+                      stream it hands over whole chunks with one write().
+     ValueFormatter:  Appends one value: std::to_chars for arithmetic T,
+                      a plain copy for string-like T, operator<< otherwise.
+
+  Basic operations are:
+     formatList(buf, list, first, last)  – "[v1, v2, ...]\n" like display,
+                                           optionally only the first and
+                                           last elements of a long list
+     formatFree(buf, pool)               – like NodePool::displayFree
+     formatUsed(buf, pool)               – like NodePool::displayUsed
+     writeList(os, list, first, last)    – formatList + one os.write
+
+  Floating-point values are written in shortest round-trip form, which
+  can differ from the 6 significant digits operator<< prints by default.
+-------------------------------------------------------------------------*/
+
+#ifndef FORMATTER_H
+#define FORMATTER_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+static const size_t FORMAT_CHUNK = 64 * 1024;
+static const size_t FORMAT_ALL = std::numeric_limits<size_t>::max();
+
+/***** FormatBuffer class *****/
+class FormatBuffer
+{
+public:
+    explicit FormatBuffer(std::ostream *sink = 0, size_t chunkBytes = FORMAT_CHUNK);
+    /*----------------------------------------------------------------------
+      Precondition:  sink (if any) outlives the buffer.
+      Postcondition: Without a sink the buffer only grows (read it with
+                     data()/size()); with one, every chunkBytes of output
+                     are passed on in a single write().
+    -----------------------------------------------------------------------*/
+
+    ~FormatBuffer();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Remaining output is flushed to the sink, if any.
+    -----------------------------------------------------------------------*/
+
+    void append(const char *chars, size_t count);
+    void append(std::string_view text);
+    void append(char c);
+
+    const char *data() const;
+    size_t size() const;
+    void clear();
+    /*----------------------------------------------------------------------
+      clear keeps the capacity, so a reused buffer stops allocating once
+      it has grown to the largest dump.
+    -----------------------------------------------------------------------*/
+
+    void flush();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Buffered output is written to the sink with one
+                     write() and the buffer is emptied (no-op without a
+                     sink).
+    -----------------------------------------------------------------------*/
+
+private:
+    FormatBuffer(const FormatBuffer &);
+    FormatBuffer &operator=(const FormatBuffer &);
+
+    /******** Data Members ********/
+    std::vector<char> chars;
+    std::ostream *sink;
+    size_t chunk;
+
+}; //--- end of FormatBuffer class
+
+inline FormatBuffer::FormatBuffer(std::ostream *s, size_t chunkBytes)
+    : sink(s), chunk(chunkBytes)
+{
+    if (sink)
+        chars.reserve(chunk + 256);
+}
+
+inline FormatBuffer::~FormatBuffer()
+{
+    flush();
+}
+
+inline void FormatBuffer::append(const char *text, size_t count)
+{
+    chars.insert(chars.end(), text, text + count);
+    if (sink && chars.size() >= chunk)
+        flush();
+}
+
+inline void FormatBuffer::append(std::string_view text)
+{
+    append(text.data(), text.size());
+}
+
+inline void FormatBuffer::append(char c)
+{
+    chars.push_back(c);
+    if (sink && chars.size() >= chunk)
+        flush();
+}
+
+inline const char *FormatBuffer::data() const
+{
+    return chars.data();
+}
+
+inline size_t FormatBuffer::size() const
+{
+    return chars.size();
+}
+
+inline void FormatBuffer::clear()
+{
+    chars.clear();
+}
+
+inline void FormatBuffer::flush()
+{
+    if (!sink || chars.empty())
+        return;
+    sink->write(chars.data(), (std::streamsize)chars.size());
+    chars.clear();
+}
+
+/***** ValueFormatter *****/
+template <typename T, typename = void>
+struct HasStringView : std::false_type {};
+
+template <typename T>
+struct HasStringView<T, decltype((void)std::string_view(std::declval<const T &>().view()))>
+    : std::true_type {};
+
+template <typename T>
+struct ValueFormatter
+{
+    static void append(FormatBuffer &buf, const T &value)
+    {
+        if constexpr (std::is_same<T, bool>::value)
+            buf.append(value ? '1' : '0');
+        else if constexpr (std::is_same<T, char>::value)
+            buf.append(value);
+        else if constexpr (std::is_arithmetic<T>::value &&
+                           !std::is_same<T, signed char>::value &&
+                           !std::is_same<T, unsigned char>::value)
+        {
+            char digits[64];
+            std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), value);
+            buf.append(digits, (size_t)(r.ptr - digits));
+        }
+        else if constexpr (std::is_convertible<const T &, std::string_view>::value)
+            buf.append(std::string_view(value));
+        else if constexpr (HasStringView<T>::value)
+            buf.append(value.view());
+        else
+        {
+            // Any other type: its operator<< into a reused string stream
+            static std::ostringstream os;
+            os.str(std::string());
+            os.clear();
+            os << value;
+            buf.append(os.str());
+        }
+    }
+};
+/*----------------------------------------------------------------------
+  Precondition:  T is arithmetic, string-like (converts to string_view or
+                 has view()), or has operator<<.
+  Postcondition: The text operator<< would print for value is appended
+                 (floating point: shortest round-trip form).
+-----------------------------------------------------------------------*/
+
+/***** formatList *****/
+template <typename T, int NUM_NODES>
+void formatList(FormatBuffer &buf, const ArrayLinkedList<T, NUM_NODES> &list,
+                size_t first = FORMAT_ALL, size_t last = 0)
+{
+    const NodePool<T, NUM_NODES> &pool = list.getPool();
+    int ptr = list.getHead();
+    buf.append('[');
+    if (ptr == NULL_INDEX)
+    {
+        buf.append(std::string_view("The list is Empty]\n"));
+        return;
+    }
+
+    size_t skip = 0; // elements left out between the first and last ones
+    if (first != FORMAT_ALL)
+    {
+        size_t count = 0;
+        for (int p = ptr; p != NULL_INDEX; p = pool.node(p).next)
+            ++count;
+        if (count > first + last)
+            skip = count - first - last;
+    }
+
+    size_t position = 0;
+    while (ptr != NULL_INDEX)
+    {
+        if (skip > 0 && position == first)
+        {
+            for (size_t k = 0; k < skip; ++k)
+                ptr = pool.node(ptr).next;
+            position += skip;
+
+            char digits[32];
+            std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), skip);
+            buf.append(std::string_view("... ("));
+            buf.append(digits, (size_t)(r.ptr - digits));
+            buf.append(std::string_view(" more)"));
+            if (ptr == NULL_INDEX)
+                break;
+            buf.append(std::string_view(", "));
+        }
+
+        ValueFormatter<T>::append(buf, pool.node(ptr).data);
+        ptr = pool.node(ptr).next;
+        ++position;
+        if (ptr != NULL_INDEX)
+            buf.append(std::string_view(", "));
+    }
+    buf.append(std::string_view("]\n"));
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: The list is appended in display() format. If first is
+                 given and the list is longer than first + last, only the
+                 first `first` and last `last` elements are written, with
+                 "... (n more)" in between.
+-----------------------------------------------------------------------*/
+
+/***** writeList *****/
+template <typename T, int NUM_NODES>
+void writeList(std::ostream &os, const ArrayLinkedList<T, NUM_NODES> &list,
+               size_t first = FORMAT_ALL, size_t last = 0)
+{
+    FormatBuffer buf(&os);
+    formatList(buf, list, first, last);
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Same output as formatList, passed to os in chunks of
+                 FORMAT_CHUNK bytes (one write for most lists).
+-----------------------------------------------------------------------*/
+
+/***** formatFree / formatUsed *****/
+template <typename T, int NUM_NODES>
+void formatFree(FormatBuffer &buf, const NodePool<T, NUM_NODES> &pool)
+{
+    char digits[16];
+    bool firstIndex = true;
+    buf.append('[');
+    for (int ptr = pool.nextFree(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+    {
+        if (!firstIndex)
+            buf.append(std::string_view(", "));
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), ptr);
+        buf.append(digits, (size_t)(r.ptr - digits));
+        firstIndex = false;
+    }
+    buf.append(']');
+}
+
+template <typename T, int NUM_NODES>
+void formatUsed(FormatBuffer &buf, const NodePool<T, NUM_NODES> &pool)
+{
+    const unsigned char *owners = pool.owners();
+    char digits[16];
+    bool firstIndex = true;
+    buf.append('[');
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        if (owners[i] == FREE_OWNER)
+            continue;
+        if (!firstIndex)
+            buf.append(std::string_view(", "));
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), i);
+        buf.append(digits, (size_t)(r.ptr - digits));
+        firstIndex = false;
+    }
+    buf.append(']');
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: The same text as displayFree / displayUsed is appended.
+-----------------------------------------------------------------------*/
+
+#endif // FORMATTER_H
@@ -0,0 +1,423 @@
+/*-- Instrument.h ----------------------------------------------------------
+
+  This header file defines compile-time switchable instrumentation for
+  ArrayLinkedList and NodePool.
+
+  Build with -DLIST_INSTRUMENTATION to count, per list operation type,
+  the number of calls and the number of node hops (next-index follows),
+  and per process the NodePool alloc / free / full events. Without the
+  macro every hook expands to nothing and the report functions only
+  print a note, so instrumented call sites cost nothing.
+
+  Hooks (used inside List.h / NodePool.h):
+     LIST_OP(id)            – at the top of an operation: count one call
+     LIST_NEXT(pool, idx)   – pool.node(idx).next, counting one hop
+     POOL_EVENT(field)      – count a NodePool event
+     POOL_EVENTS(field, n)  – count n NodePool events at once
+     POOL_HOPS(n)           – add free-list hops (acquire)
+
+  Basic operations are:
+     listStatsReport(os)    – CSV report of all counters
+     listStatsReset()       – zero all counters
+
+  Build with -DLIST_LATENCY (implies LIST_INSTRUMENTATION) to also time
+  every operation with steady_clock into per-thread log-scale
+  histograms (4 buckets per power of two of nanoseconds, 1 ns .. ~73 min)
+  that are merged when read:
+     listLatencyPercentile(op, q)  – latency (ns) at quantile q of op
+     listLatencyReport(os)         – CSV p50 / p99 / p999 / max per op
+     listLatencyReset()            – zero all histograms
+
+  Nested operations (operator+= calling insertBack) are counted under
+  both names; hops belong to the function that made them, time includes
+  the nested calls.
+-------------------------------------------------------------------------*/
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <iostream>
+
+#if defined(LIST_LATENCY) && !defined(LIST_INSTRUMENTATION)
+#define LIST_INSTRUMENTATION
+#endif
+
+/***** ListOpId *****/
+enum ListOpId
+{
+    LOP_COPY, LOP_ASSIGN, LOP_SIZE, LOP_CLEAR, LOP_DISPLAY,
+    LOP_INSERT_FRONT, LOP_INSERT_BACK, LOP_INSERT_BEFORE, LOP_INSERT_AFTER,
+    LOP_INSERT_AT, LOP_INSERT_AT_POSITION, LOP_INSERT_SORTED, LOP_INSERT_SORTED_DESC,
+    LOP_DELETE_FRONT, LOP_DELETE_BACK, LOP_REMOVE_SLOT, LOP_REMOVE_VALUE,
+    LOP_REMOVE_ALL, LOP_REMOVE_AFTER, LOP_REMOVE_BEFORE, LOP_REMOVE_DUPLICATES,
+    LOP_FIND, LOP_CONTAINS, LOP_COUNT, LOP_FIND_ALL, LOP_GET_AT,
+    LOP_REVERSE, LOP_SORT_ASC, LOP_SORT_DESC, LOP_APPEND, LOP_ATTACH,
+    LOP_MERGE, LOP_UNION, LOP_INTERSECTION, LOP_DIFFERENCE, // CombineMode order
+    LOP_ERASE_IF, LOP_RETAIN_IF, LOP_APPEND_CHAIN,
+    LOP_COUNT_OF_OPS
+};
+
+inline const char *listOpName(int id)
+{
+    static const char *const names[LOP_COUNT_OF_OPS] = {
+        "copy", "operator=", "size", "clear", "display",
+        "insertFront", "insertBack", "insertBefore", "insertAfter",
+        "insertAt", "insertAtPosition", "insertSorted", "insertSortedDescending",
+        "deleteFront", "deleteBack", "removeSlot", "removeValue",
+        "removeAllOccurrences", "removeAfter", "removeBefore", "removeDuplicates",
+        "find", "contains", "count", "findAll", "getAt",
+        "reverse", "sortAscending", "sortDescending", "operator+=", "attach",
+        "merge", "setUnion", "setIntersection", "setDifference",
+        "eraseIf", "retainIf", "appendChain"};
+    return (id >= 0 && id < LOP_COUNT_OF_OPS) ? names[id] : "?";
+}
+
+#ifdef LIST_INSTRUMENTATION
+
+#include <atomic>
+#ifdef LIST_LATENCY
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#endif
+
+/***** counters *****/
+struct ListStatsTable
+{
+    std::atomic<unsigned long long> calls[LOP_COUNT_OF_OPS];
+    std::atomic<unsigned long long> hops[LOP_COUNT_OF_OPS];
+    std::atomic<unsigned long long> poolAlloc;       // newNode / acquire succeeded
+    std::atomic<unsigned long long> poolFree;        // deleteNode
+    std::atomic<unsigned long long> poolFull;        // newNode found no free node
+    std::atomic<unsigned long long> poolAcquireMiss; // acquire of a used slot
+    std::atomic<unsigned long long> poolAcquireHops; // free-list nodes walked
+};
+
+inline ListStatsTable &listStats()
+{
+    static ListStatsTable table; // zero-initialised (static storage)
+    return table;
+}
+
+#ifdef LIST_LATENCY
+
+/***** latency histograms *****/
+static const int LATENCY_SUB_BITS = 2;                 // 4 buckets per octave
+static const int LATENCY_OCTAVES = 40;                 // up to 2^42 ns
+static const int LATENCY_BUCKETS = (LATENCY_OCTAVES + 1) << LATENCY_SUB_BITS;
+
+// Bucket of a latency: exact below 4 ns, then 4 per power of two
+inline int latencyBucket(std::uint64_t ns)
+{
+    const int sub = 1 << LATENCY_SUB_BITS;
+    if (ns < (std::uint64_t)sub)
+        return (int)ns;
+    int msb = 63 - __builtin_clzll(ns);
+    int idx = ((msb - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS) +
+              (int)((ns >> (msb - LATENCY_SUB_BITS)) & (sub - 1));
+    return idx < LATENCY_BUCKETS ? idx : LATENCY_BUCKETS - 1;
+}
+
+// Largest latency (ns) that falls into bucket idx
+inline std::uint64_t latencyBucketLimit(int idx)
+{
+    const int sub = 1 << LATENCY_SUB_BITS;
+    if (idx < sub)
+        return (std::uint64_t)idx;
+    int shift = (idx >> LATENCY_SUB_BITS) - 1;
+    return ((std::uint64_t)(sub + (idx & (sub - 1)) + 1) << shift) - 1;
+}
+
+// Written by one thread only, read by the exporter: relaxed load + store
+struct LatencyHistogram
+{
+    std::atomic<std::uint64_t> buckets[LATENCY_BUCKETS];
+    std::atomic<std::uint64_t> maxNs;
+
+    void add(std::uint64_t ns)
+    {
+        std::atomic<std::uint64_t> &b = buckets[latencyBucket(ns)];
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (ns > maxNs.load(std::memory_order_relaxed))
+            maxNs.store(ns, std::memory_order_relaxed);
+    }
+};
+
+struct ListLatencyTable
+{
+    LatencyHistogram ops[LOP_COUNT_OF_OPS];
+};
+
+// Live per-thread tables plus the sum of those of finished threads
+struct ListLatencyRegistry
+{
+    std::mutex lock;
+    std::vector<ListLatencyTable *> live;
+    ListLatencyTable retired;
+};
+
+inline ListLatencyRegistry &listLatencyRegistry()
+{
+    static ListLatencyRegistry registry;
+    return registry;
+}
+
+inline void addLatencyHistogram(LatencyHistogram &dst, const LatencyHistogram &src)
+{
+    for (int i = 0; i < LATENCY_BUCKETS; ++i)
+        dst.buckets[i].store(dst.buckets[i].load(std::memory_order_relaxed) +
+                                 src.buckets[i].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    if (src.maxNs.load(std::memory_order_relaxed) > dst.maxNs.load(std::memory_order_relaxed))
+        dst.maxNs.store(src.maxNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+inline void addLatencyTable(ListLatencyTable &into, const ListLatencyTable &from)
+{
+    for (int op = 0; op < LOP_COUNT_OF_OPS; ++op)
+        addLatencyHistogram(into.ops[op], from.ops[op]);
+}
+
+// This thread's table; registered on first use, folded into `retired`
+// when the thread exits
+class ListLatencyThread
+{
+public:
+    ListLatencyThread() : table(new ListLatencyTable())
+    {
+        ListLatencyRegistry &r = listLatencyRegistry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.live.push_back(table);
+    }
+    ~ListLatencyThread()
+    {
+        ListLatencyRegistry &r = listLatencyRegistry();
+        {
+            std::lock_guard<std::mutex> guard(r.lock);
+            addLatencyTable(r.retired, *table);
+            for (size_t i = 0; i < r.live.size(); ++i)
+                if (r.live[i] == table)
+                {
+                    r.live[i] = r.live.back();
+                    r.live.pop_back();
+                    break;
+                }
+        }
+        delete table;
+    }
+
+    ListLatencyTable *table;
+
+private:
+    ListLatencyThread(const ListLatencyThread &);
+    ListLatencyThread &operator=(const ListLatencyThread &);
+};
+
+inline ListLatencyTable &threadLatencyTable()
+{
+    thread_local ListLatencyThread mine;
+    return *mine.table;
+}
+
+#endif // LIST_LATENCY
+
+// Collects the hops (and time) of one call and publishes them once at
+// scope exit
+class ListOpScope
+{
+public:
+    explicit ListOpScope(ListOpId op) : id(op), hops(0)
+    {
+        listStats().calls[id].fetch_add(1, std::memory_order_relaxed);
+#ifdef LIST_LATENCY
+        start = std::chrono::steady_clock::now();
+#endif
+    }
+    ~ListOpScope()
+    {
+#ifdef LIST_LATENCY
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        threadLatencyTable().ops[id].add((std::uint64_t)elapsed.count());
+#endif
+        if (hops)
+            listStats().hops[id].fetch_add(hops, std::memory_order_relaxed);
+    }
+
+    ListOpId id;
+    unsigned long long hops;
+#ifdef LIST_LATENCY
+    std::chrono::steady_clock::time_point start;
+#endif
+};
+
+#define LIST_OP(id) ListOpScope listOpScope_(id)
+#define LIST_NEXT(pool, idx) (++listOpScope_.hops, (pool).node(idx).next)
+#define POOL_EVENT(field) listStats().field.fetch_add(1, std::memory_order_relaxed)
+#define POOL_EVENTS(field, n) listStats().field.fetch_add((n), std::memory_order_relaxed)
+#define POOL_HOPS(n) listStats().poolAcquireHops.fetch_add((n), std::memory_order_relaxed)
+
+inline void listStatsReset()
+{
+    ListStatsTable &t = listStats();
+    for (int i = 0; i < LOP_COUNT_OF_OPS; ++i)
+    {
+        t.calls[i].store(0);
+        t.hops[i].store(0);
+    }
+    t.poolAlloc.store(0);
+    t.poolFree.store(0);
+    t.poolFull.store(0);
+    t.poolAcquireMiss.store(0);
+    t.poolAcquireHops.store(0);
+}
+
+inline void listStatsReport(std::ostream &os)
+{
+    ListStatsTable &t = listStats();
+    os << "op,calls,hops,hops_per_call\n";
+    for (int i = 0; i < LOP_COUNT_OF_OPS; ++i)
+    {
+        unsigned long long calls = t.calls[i].load(), hops = t.hops[i].load();
+        if (calls == 0)
+            continue;
+        os << listOpName(i) << "," << calls << "," << hops << "," << (double)hops / calls << "\n";
+    }
+    os << "pool_event,count\n"
+       << "alloc," << t.poolAlloc.load() << "\n"
+       << "free," << t.poolFree.load() << "\n"
+       << "full," << t.poolFull.load() << "\n"
+       << "acquire_miss," << t.poolAcquireMiss.load() << "\n"
+       << "acquire_hops," << t.poolAcquireHops.load() << "\n";
+}
+
+#ifdef LIST_LATENCY
+
+// Add every thread's histogram of op to out (call with the registry
+// locked; out starts zeroed)
+inline void mergedLatency(int op, LatencyHistogram &out)
+{
+    ListLatencyRegistry &r = listLatencyRegistry();
+    addLatencyHistogram(out, r.retired.ops[op]);
+    for (size_t i = 0; i < r.live.size(); ++i)
+        addLatencyHistogram(out, r.live[i]->ops[op]);
+}
+
+inline std::uint64_t latencyQuantile(const LatencyHistogram &h, double q)
+{
+    std::uint64_t total = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; ++i)
+        total += h.buckets[i].load();
+    if (total == 0)
+        return 0;
+    std::uint64_t rank = (std::uint64_t)(q * (double)total);
+    if (rank >= total)
+        rank = total - 1;
+    std::uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; ++i)
+    {
+        seen += h.buckets[i].load();
+        if (seen > rank)
+        {
+            std::uint64_t limit = latencyBucketLimit(i);
+            return limit < h.maxNs.load() ? limit : h.maxNs.load();
+        }
+    }
+    return h.maxNs.load();
+}
+
+inline unsigned long long listLatencyPercentile(int op, double q)
+{
+    if (op < 0 || op >= LOP_COUNT_OF_OPS)
+        return 0;
+    ListLatencyRegistry &r = listLatencyRegistry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    LatencyHistogram h = LatencyHistogram();
+    mergedLatency(op, h);
+    return latencyQuantile(h, q);
+}
+
+inline void listLatencyReset()
+{
+    ListLatencyRegistry &r = listLatencyRegistry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (size_t t = 0; t <= r.live.size(); ++t)
+    {
+        ListLatencyTable &table = t == 0 ? r.retired : *r.live[t - 1];
+        for (int op = 0; op < LOP_COUNT_OF_OPS; ++op)
+        {
+            for (int i = 0; i < LATENCY_BUCKETS; ++i)
+                table.ops[op].buckets[i].store(0, std::memory_order_relaxed);
+            table.ops[op].maxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+inline void listLatencyReport(std::ostream &os)
+{
+    ListLatencyRegistry &r = listLatencyRegistry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    os << "op,count,p50_ns,p99_ns,p999_ns,max_ns\n";
+    for (int op = 0; op < LOP_COUNT_OF_OPS; ++op)
+    {
+        LatencyHistogram h = LatencyHistogram();
+        mergedLatency(op, h);
+        std::uint64_t count = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; ++i)
+            count += h.buckets[i].load();
+        if (count == 0)
+            continue;
+        os << listOpName(op) << "," << count << "," << latencyQuantile(h, 0.5) << ","
+           << latencyQuantile(h, 0.99) << "," << latencyQuantile(h, 0.999) << ","
+           << h.maxNs.load() << "\n";
+    }
+}
+
+#endif // LIST_LATENCY
+
+#else
+
+#define LIST_OP(id) ((void)0)
+#define LIST_NEXT(pool, idx) ((pool).node(idx).next)
+#define POOL_EVENT(field) ((void)0)
+#define POOL_EVENTS(field, n) ((void)0)
+#define POOL_HOPS(n) ((void)0)
+
+inline void listStatsReset() {}
+
+inline void listStatsReport(std::ostream &os)
+{
+    os << "# list instrumentation disabled (build with -DLIST_INSTRUMENTATION)\n";
+}
+
+#endif // LIST_INSTRUMENTATION
+
+#ifndef LIST_LATENCY
+
+inline unsigned long long listLatencyPercentile(int, double) { return 0; }
+inline void listLatencyReset() {}
+
+inline void listLatencyReport(std::ostream &os)
+{
+    os << "# list latency histograms disabled (build with -DLIST_LATENCY)\n";
+}
+
+#endif // LIST_LATENCY
+
+/*----------------------------------------------------------------------
+  listStatsReport
+  Precondition:  None
+  Postcondition: Writes "op,calls,hops,hops_per_call" rows for every
+                 operation called so far, then the pool event counts.
+-----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  listLatencyPercentile / listLatencyReport
+  Precondition:  0 <= q <= 1
+  Postcondition: Histograms of all threads (live and finished) are merged
+                 under the registry lock. A percentile is the upper limit
+                 of its bucket (at most 25% above the true value), capped
+                 by the largest latency seen; 0 without samples.
+-----------------------------------------------------------------------*/
+
+#endif // INSTRUMENT_H
@@ -0,0 +1,630 @@
+/*-- Journal.h -------------------------------------------------------------
+
+  This header file defines a write-ahead log for list mutations, used
+  together with Snapshot.h for durability between snapshots.
+
+     MutationLog:        Append-only log file with group commit: records
+                         collect in a buffer and are written and
+                         fdatasync'ed together once groupBytes are pending
+                         or the oldest pending record is groupMillis old.
+     JournaledList<T,N>: Wraps an ArrayLinkedList; every successful
+                         mutation appends one record to a MutationLog.
+     replayJournal:      Re-apply a log on top of the snapshot it follows.
+
+  Record layout (native byte order, no padding):
+     uint8 op, uint8 listId, int32 slot, payload...
+  slot is the pool index the mutation allocated or freed (NULL_INDEX for
+  whole-list operations); payload is the value (and key, for INSERT_AFTER)
+  encoded with SnapshotCodec<T>, so an int record is 10 bytes.
+
+  Replay is deterministic: the snapshot restores the exact free list, so
+  re-running the same operations hands out the same slots. Every
+  mutation of the pool must therefore go through JournaledLists (list
+  ids = positions in the vector given to saveSnapshot / loadSnapshot /
+  replayJournal).
+
+  The log header carries the sequence number of the snapshot the log was
+  started after (see Snapshot.h). Replay skips a log older than the
+  loaded snapshot and rejects a newer one; the recorded slots are a
+  further check within a matching log.
+
+  With std::vector<ArrayLinkedList<T, N> *> lists (the same vector works
+  for saving and loading):
+
+  Recovery:
+     seq = loadSnapshotFile(snap, pool, lists);
+     replayJournalFile(wal, lists, seq);
+     MutationLog log(wal);
+     if (log.snapshotSequence() != seq) log.truncate(seq);
+  Checkpoint:
+     log.commit();
+     seq = log.snapshotSequence() + 1;
+     saveSnapshotFile(snap, pool, lists, seq);
+     log.truncate(seq);
+  (a crash between the last two steps leaves a log whose records are
+  already in the snapshot; its older sequence number makes replay skip
+  it, and recovery then restarts it.)
+
+  A log is (re)started by writing its header to path.tmp, syncing it and
+  renaming it over path (then syncing the directory), so a crash leaves
+  either the old log or the new one. A log shorter than its header can
+  only be a creation that never finished: replay treats it as empty and
+  MutationLog starts it again.
+-------------------------------------------------------------------------*/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "NodePool.h"
+#include "List.h"
+#include "Snapshot.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/***** JournalOp *****/
+enum JournalOp
+{
+    JOP_INSERT_FRONT = 1,
+    JOP_INSERT_BACK,
+    JOP_INSERT_SORTED,
+    JOP_INSERT_AFTER,
+    JOP_DELETE_FRONT,
+    JOP_DELETE_BACK,
+    JOP_REMOVE_SLOT,
+    JOP_REMOVE_VALUE,
+    JOP_CLEAR,
+    JOP_REVERSE,
+    JOP_SORT_ASCENDING,
+    JOP_SORT_DESCENDING
+};
+
+static const unsigned int JOURNAL_VERSION = 2; // 2: snapshot sequence number
+static const size_t JOURNAL_RECORD_HEADER = 6; // op, listId, slot
+
+/***** JournalHeader *****/
+struct JournalHeader
+{
+    char magic[8];            // "NPOOLWAL"
+    unsigned int version;     // JOURNAL_VERSION
+    unsigned int byteOrder;   // 0x01020304 as written
+    unsigned long long snapshotSeq; // snapshot this log was started after
+};
+
+/***** MutationLog class *****/
+class MutationLog
+{
+public:
+    /***** Class constructor *****/
+    explicit MutationLog(const std::string &path, size_t groupBytes = 64 * 1024,
+                         int groupMillis = 10);
+    /*----------------------------------------------------------------------
+      Open the log at path for appending (created with a header if
+      missing, empty, or cut short inside the header).
+
+      Precondition:  path was written by MutationLog or does not exist.
+      Postcondition: New records go after the existing ones.
+      Throws: std::runtime_error on I/O errors or a foreign file.
+    -----------------------------------------------------------------------*/
+
+    /***** Class destructor *****/
+    ~MutationLog();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Pending records are committed; the file is closed.
+    -----------------------------------------------------------------------*/
+
+    std::vector<char> &pending();
+    void recordAdded();
+    /*----------------------------------------------------------------------
+      Writers append one encoded record to pending(), then call
+      recordAdded().
+
+      Precondition:  pending() ends with a complete record.
+      Postcondition: The group is committed if a threshold is reached.
+                     The time limit is only checked here (there is no
+                     background thread); call commit() when going idle.
+    -----------------------------------------------------------------------*/
+
+    void commit();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Every record appended so far is on disk (one write
+                     and one fdatasync for the whole group).
+      Throws: std::runtime_error if writing or syncing fails.
+    -----------------------------------------------------------------------*/
+
+    void truncate(unsigned long long snapshotSeq);
+    /*----------------------------------------------------------------------
+      Precondition:  A snapshot including every logged record was saved
+                     with sequence number snapshotSeq.
+      Postcondition: The log holds only its header (synced), which now
+                     names snapshotSeq; pending records are dropped. The
+                     new log replaces the old one by rename, so a crash
+                     leaves one or the other.
+      Throws: std::runtime_error on I/O errors; a failure before the
+              rename leaves the old log in use.
+    -----------------------------------------------------------------------*/
+
+    unsigned long long snapshotSequence() const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns the snapshot sequence number in the header
+                     (0 for a new log).
+    -----------------------------------------------------------------------*/
+
+    size_t pendingBytes() const;
+    unsigned long long commitCount() const;
+
+private:
+    MutationLog(const MutationLog &);
+    MutationLog &operator=(const MutationLog &);
+
+    void writeAll(const char *data, size_t bytes);
+    void restart(unsigned long long snapshotSeq);
+
+    /******** Data Members ********/
+    int fd;
+    std::string path;
+    std::vector<char> buffer;   // encoded records not yet written
+    size_t groupBytes;          // commit once this much is pending
+    std::chrono::milliseconds groupDelay;
+    std::chrono::steady_clock::time_point oldestPending;
+    unsigned long long commits;
+    unsigned long long snapshotSeq; // as stored in the header
+
+}; //--- end of MutationLog class
+
+/***** JournaledList class *****/
+template <typename T, int NUM_NODES>
+class JournaledList
+{
+public:
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+    typedef SnapshotCodec<T> Codec;
+
+    JournaledList(List &list, MutationLog &log, unsigned char listId);
+    /*----------------------------------------------------------------------
+      Precondition:  listId is the list's position in the vector passed to
+                     saveSnapshot / replayJournal.
+      Postcondition: Mutations made through this object are logged.
+    -----------------------------------------------------------------------*/
+
+    bool insertFront(const T &value);
+    bool insertBack(const T &value);
+    bool insertSorted(const T &value);
+    bool insertAfter(const T &key, const T &value);
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Same as the ArrayLinkedList operation, except that a
+                     full pool returns false instead of prompting. Only
+                     successful inserts are logged.
+    -----------------------------------------------------------------------*/
+
+    bool deleteFront();
+    bool deleteBack();
+    bool removeSlot(int slotIdx);
+    bool removeValue(const T &value);
+    void clear();
+    void reverse();
+    void sortAscending();
+    void sortDescending();
+
+    const List &list() const;
+
+private:
+    void record(JournalOp op, int slot, const T *key, const T *value);
+
+    /******** Data Members ********/
+    List &target;
+    MutationLog &log;
+    unsigned char listId;
+
+}; //--- end of JournaledList class
+
+/***** Implementation Section *****/
+
+inline MutationLog::MutationLog(const std::string &p, size_t bytes, int millis)
+    : fd(-1), path(p), groupBytes(bytes), groupDelay(millis), commits(0), snapshotSeq(0)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+        throw std::runtime_error("journal: cannot open " + path + ": " + std::strerror(errno));
+
+    JournalHeader header;
+    ssize_t n = ::pread(fd, &header, sizeof(header), 0);
+    if (n >= 0 && n < (ssize_t)sizeof(header) &&
+        std::memcmp(&header, "NPOOLWAL", n < 8 ? (size_t)n : 8) == 0)
+    {
+        // New, or its creation never finished: it holds no records
+        try
+        {
+            restart(0);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+        return;
+    }
+    if (n != (ssize_t)sizeof(header) || std::memcmp(header.magic, "NPOOLWAL", 8) != 0 ||
+        header.version != JOURNAL_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER)
+    {
+        ::close(fd);
+        throw std::runtime_error("journal: " + path + " is not a compatible log");
+    }
+    snapshotSeq = header.snapshotSeq;
+}
+
+inline MutationLog::~MutationLog()
+{
+    try
+    {
+        commit();
+    }
+    catch (...)
+    {
+    }
+    ::close(fd);
+}
+
+inline void MutationLog::writeAll(const char *data, size_t bytes)
+{
+    while (bytes > 0)
+    {
+        ssize_t n = ::write(fd, data, bytes);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            throw std::runtime_error("journal: write failed");
+        data += n;
+        bytes -= (size_t)n;
+    }
+}
+
+inline void MutationLog::restart(unsigned long long seq)
+{
+    JournalHeader header = JournalHeader();
+    std::memcpy(header.magic, "NPOOLWAL", 8);
+    header.version = JOURNAL_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.snapshotSeq = seq;
+
+    std::string tmp = path + ".tmp";
+    int newFd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (newFd < 0)
+        throw std::runtime_error("journal: cannot create " + tmp + ": " + std::strerror(errno));
+    int oldFd = fd;
+    fd = newFd; // writeAll writes to fd
+    try
+    {
+        writeAll(reinterpret_cast<const char *>(&header), sizeof(header));
+        if (::fdatasync(fd) != 0)
+            throw std::runtime_error("journal: fdatasync failed");
+        if (::rename(tmp.c_str(), path.c_str()) != 0)
+            throw std::runtime_error("journal: cannot rename " + tmp + ": " + std::strerror(errno));
+    }
+    catch (...)
+    {
+        fd = oldFd;
+        ::close(newFd);
+        ::unlink(tmp.c_str());
+        throw;
+    }
+    ::close(oldFd);
+    snapshotSeq = seq;
+
+    // Make the rename itself durable
+    size_t slash = path.rfind('/');
+    std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd < 0)
+        throw std::runtime_error("journal: cannot open directory " + dir);
+    int rc = ::fsync(dirFd);
+    ::close(dirFd);
+    if (rc != 0)
+        throw std::runtime_error("journal: cannot sync directory " + dir);
+}
+
+inline std::vector<char> &MutationLog::pending()
+{
+    if (buffer.empty())
+        oldestPending = std::chrono::steady_clock::now();
+    return buffer;
+}
+
+inline void MutationLog::recordAdded()
+{
+    if (buffer.size() >= groupBytes ||
+        std::chrono::steady_clock::now() - oldestPending >= groupDelay)
+        commit();
+}
+
+inline void MutationLog::commit()
+{
+    if (buffer.empty())
+        return;
+    writeAll(buffer.data(), buffer.size());
+    if (::fdatasync(fd) != 0)
+        throw std::runtime_error("journal: fdatasync failed");
+    buffer.clear();
+    ++commits;
+}
+
+inline void MutationLog::truncate(unsigned long long seq)
+{
+    restart(seq);
+    buffer.clear();
+}
+
+inline unsigned long long MutationLog::snapshotSequence() const
+{
+    return snapshotSeq;
+}
+
+inline size_t MutationLog::pendingBytes() const
+{
+    return buffer.size();
+}
+
+inline unsigned long long MutationLog::commitCount() const
+{
+    return commits;
+}
+
+template <typename T, int NUM_NODES>
+JournaledList<T, NUM_NODES>::JournaledList(List &list, MutationLog &l, unsigned char id)
+    : target(list), log(l), listId(id) {}
+
+template <typename T, int NUM_NODES>
+void JournaledList<T, NUM_NODES>::record(JournalOp op, int slot, const T *key, const T *value)
+{
+    std::vector<char> &buf = log.pending();
+    buf.push_back((char)op);
+    buf.push_back((char)listId);
+    const char *s = reinterpret_cast<const char *>(&slot);
+    buf.insert(buf.end(), s, s + sizeof(slot));
+    if (key)
+        Codec::encode(buf, *key);
+    if (value)
+        Codec::encode(buf, *value);
+    log.recordAdded();
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::insertFront(const T &value)
+{
+    int slot = target.getPool().nextFree();
+    if (slot == NULL_INDEX)
+        return false;
+    target.insertFront(value);
+    record(JOP_INSERT_FRONT, slot, 0, &value);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::insertBack(const T &value)
+{
+    int slot = target.getPool().nextFree();
+    if (slot == NULL_INDEX)
+        return false;
+    target.insertBack(value);
+    record(JOP_INSERT_BACK, slot, 0, &value);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::insertSorted(const T &value)
+{
+    int slot = target.getPool().nextFree();
+    if (slot == NULL_INDEX || !target.insertSorted(value))
+        return false;
+    record(JOP_INSERT_SORTED, slot, 0, &value);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
+{
+    int slot = target.getPool().nextFree();
+    if (slot == NULL_INDEX || !target.insertAfter(key, value))
+        return false;
+    record(JOP_INSERT_AFTER, slot, &key, &value);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::deleteFront()
+{
+    if (!target.deleteFront())
+        return false;
+    record(JOP_DELETE_FRONT, target.getPool().nextFree(), 0, 0);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::deleteBack()
+{
+    if (!target.deleteBack())
+        return false;
+    record(JOP_DELETE_BACK, target.getPool().nextFree(), 0, 0);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::removeSlot(int slotIdx)
+{
+    if (!target.removeSlot(slotIdx))
+        return false;
+    record(JOP_REMOVE_SLOT, slotIdx, 0, 0);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+bool JournaledList<T, NUM_NODES>::removeValue(const T &value)
+{
+    if (!target.removeValue(value))
+        return false;
+    record(JOP_REMOVE_VALUE, target.getPool().nextFree(), 0, &value);
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+void JournaledList<T, NUM_NODES>::clear()
+{
+    target.clear();
+    record(JOP_CLEAR, NULL_INDEX, 0, 0);
+}
+
+template <typename T, int NUM_NODES>
+void JournaledList<T, NUM_NODES>::reverse()
+{
+    target.reverse();
+    record(JOP_REVERSE, NULL_INDEX, 0, 0);
+}
+
+template <typename T, int NUM_NODES>
+void JournaledList<T, NUM_NODES>::sortAscending()
+{
+    target.sortAscending();
+    record(JOP_SORT_ASCENDING, NULL_INDEX, 0, 0);
+}
+
+template <typename T, int NUM_NODES>
+void JournaledList<T, NUM_NODES>::sortDescending()
+{
+    target.sortDescending();
+    record(JOP_SORT_DESCENDING, NULL_INDEX, 0, 0);
+}
+
+template <typename T, int NUM_NODES>
+const typename JournaledList<T, NUM_NODES>::List &JournaledList<T, NUM_NODES>::list() const
+{
+    return target;
+}
+
+/***** replayJournal *****/
+template <typename T, int NUM_NODES>
+size_t replayJournal(std::istream &is, const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists,
+                     unsigned long long snapshotSeq)
+{
+    typedef SnapshotCodec<T> Codec;
+    std::vector<char> bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+    JournalHeader header;
+    if (bytes.size() < sizeof(header))
+    {
+        // A creation that never finished holds no records
+        if (!bytes.empty() &&
+            std::memcmp(bytes.data(), "NPOOLWAL", bytes.size() < 8 ? bytes.size() : 8) != 0)
+            throw std::runtime_error("journal: not a compatible log");
+        return 0;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, "NPOOLWAL", 8) != 0 || header.version != JOURNAL_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER)
+        throw std::runtime_error("journal: not a compatible log");
+    if (header.snapshotSeq < snapshotSeq)
+        return 0; // checkpoint crashed before truncate: already in the snapshot
+    if (header.snapshotSeq > snapshotSeq)
+        throw std::runtime_error("journal: log was started after a newer snapshot");
+
+    const char *p = bytes.data() + sizeof(header);
+    const char *end = bytes.data() + bytes.size();
+    size_t replayed = 0;
+    while ((size_t)(end - p) >= JOURNAL_RECORD_HEADER)
+    {
+        int op = (unsigned char)p[0];
+        unsigned int listId = (unsigned char)p[1];
+        int slot;
+        std::memcpy(&slot, p + 2, sizeof(slot));
+        const char *q = p + JOURNAL_RECORD_HEADER;
+        if (op < JOP_INSERT_FRONT || op > JOP_SORT_DESCENDING)
+            throw std::runtime_error("journal: unknown record type");
+
+        T key = T(), value = T();
+        try
+        {
+            if (op == JOP_INSERT_AFTER)
+                q = Codec::decode(q, end, key);
+            if (op <= JOP_INSERT_AFTER || op == JOP_REMOVE_VALUE)
+                q = Codec::decode(q, end, value);
+        }
+        catch (const std::runtime_error &)
+        {
+            break; // torn final record: it was never committed
+        }
+
+        if (listId >= lists.size())
+            throw std::runtime_error("journal: record for an unknown list");
+        ArrayLinkedList<T, NUM_NODES> &list = *lists[listId];
+        NodePool<T, NUM_NODES> &pool = list.getPool();
+
+        bool ok = true;
+        if (op <= JOP_INSERT_AFTER && pool.nextFree() != slot)
+            ok = false;
+        else if (op == JOP_INSERT_FRONT)
+            list.insertFront(value);
+        else if (op == JOP_INSERT_BACK)
+            list.insertBack(value);
+        else if (op == JOP_INSERT_SORTED)
+            ok = static_cast<bool>(list.insertSorted(value));
+        else if (op == JOP_INSERT_AFTER)
+            ok = static_cast<bool>(list.insertAfter(key, value));
+        else if (op == JOP_DELETE_FRONT)
+            ok = list.deleteFront() && pool.nextFree() == slot;
+        else if (op == JOP_DELETE_BACK)
+            ok = list.deleteBack() && pool.nextFree() == slot;
+        else if (op == JOP_REMOVE_SLOT)
+            ok = list.removeSlot(slot);
+        else if (op == JOP_REMOVE_VALUE)
+            ok = list.removeValue(value) && pool.nextFree() == slot;
+        else if (op == JOP_CLEAR)
+            list.clear();
+        else if (op == JOP_REVERSE)
+            list.reverse();
+        else if (op == JOP_SORT_ASCENDING)
+            list.sortAscending();
+        else
+            list.sortDescending();
+        if (!ok)
+            throw std::runtime_error("journal: log does not match the snapshot");
+
+        p = q;
+        ++replayed;
+    }
+    return replayed;
+}
+/*----------------------------------------------------------------------
+  Precondition:  The pool and lists were restored from the snapshot with
+                 sequence number snapshotSeq (same list order).
+  Postcondition: If the log was started after that snapshot, every
+                 complete record has been re-applied; a torn final record
+                 is ignored. A log from an older snapshot, or one cut
+                 short inside its header, is skipped.
+                 Returns the number replayed.
+  Throws: std::runtime_error for a foreign log, a log started after a
+          newer snapshot, or a record that does not reproduce the logged
+          slot.
+-----------------------------------------------------------------------*/
+
+/***** replayJournalFile *****/
+template <typename T, int NUM_NODES>
+size_t replayJournalFile(const std::string &path, const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists,
+                         unsigned long long snapshotSeq)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    if (!is)
+        return 0; // no log yet: nothing to replay
+    return replayJournal(is, lists, snapshotSeq);
+}
+
+#endif // JOURNAL_H
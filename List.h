@@ -6,6 +6,7 @@
   Public operations include:
      • Constructor                     – build an empty list from a NodePool  
      • Copy constructor                – deep-copy another list  
+     • View constructor                – wrap a chain tagged elsewhere
      • Destructor                      – return all nodes to the pool  
      • operator=                       – assign one list to another  
      • operator+=, operator+           – append/concatenate lists  
@@ -31,12 +32,35 @@
      • removeSlot(slotIdx)             – remove by pool index  
      • removeValue(value)              – remove first match  
      • removeAllOccurrences(value)     – remove every match  
+     • eraseIf(pred), retainIf(pred)   – one-pass removal by predicate
      • removeAfter(key)                – remove node after first key  
      • removeBefore(key)               – remove node before first key  
 
+  Inserts return a NodeHandle (slot + generation) to the new node, null
+  on failure; it tests false like the old bool result.
+
+  Handle operations (O(1) validation, stale handles fail cleanly):
+     • holds(h), get(h)                – validate / access by handle
+     • findHandle(key)                 – handle of the first match
+     • insertAfter(h, value)           – insert after a handle's node
+     • erase(h)                        – remove a handle's node
+
+  Cursor (remembers the previous node, edits at the cursor are O(1)):
+     • cursor()                        – cursor on the first element
+     • advance(), seek(key)            – move forward
+     • insertBefore(v), insertAfter(v),
+       erase()                         – edit at the cursor
+
   Search & access:
      • find(value)                     – return zero-based index or –1  
+     • contains(value)                 – test membership (pool scan)
+     • count(value)                    – count matches (pool scan)
+     • findAll(value)                  – pool slots holding value
      • getAt(position)                 – reference element by position  
+     • getPool(), getHead(),
+       getOwnerTag()                   – raw access for bulk algorithms
+     • attach(head), detach()          – adopt / release a node chain
+     • appendChain(first, last)        – link a tagged chain after the tail
 
   Other utilities:
      • reverse()                       – reverse the list in-place  
@@ -44,6 +68,19 @@
      • sortAscending()                – in-place ascending sort  
      • sortDescending()               – in-place descending sort  
 
+  Sorted-list combine operations (linear time, relink nodes):
+     • merge(other)                    – merge sorted other into this list
+     • setUnion(other)                 – keep values in either list
+     • setIntersection(other)          – keep values in both lists
+     • setDifference(other)            – keep values not in other
+
+  Built with -DLIST_INSTRUMENTATION every public operation counts its
+  calls and node hops (Instrument.h, listStatsReport); otherwise the
+  hooks compile to plain pool.node(idx).next reads.
+
+  From C++20 on every operation except display and findAll is constexpr
+  for literal T, so lists can be built at compile time (StaticList.h).
+
 -------------------------------------------------------------------------*/
 
 
@@ -51,8 +88,35 @@
 #define LIST_H
 
 #include "NodePool.h"
+#include "SimdScan.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/***** readValue helper *****/
+template <typename T>
+std::istream &readValue(std::istream &is, T &value)
+{
+    is >> value;
+    is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    return is;
+}
+
+inline std::istream &readValue(std::istream &is, std::string &value)
+{
+    return std::getline(is, value);
+}
+/*----------------------------------------------------------------------
+  Read one value typed by the user (whole line for strings).
+
+  Precondition:  is is a valid input stream.
+  Postcondition: value holds the parsed input; the rest of the line is
+                 consumed.
+-----------------------------------------------------------------------*/
 
 /***** Template Class Definition *****/
 template <typename T, int NUM_NODES>
@@ -62,7 +126,7 @@ public:
     /******** Function Members ********/
 
 /***** Class constructor *****/
-ArrayLinkedList(NodePool<T, NUM_NODES> &p);
+POOL_CONSTEXPR ArrayLinkedList(NodePool<T, NUM_NODES> &p);
 /*----------------------------------------------------------------------
   Construct an ArrayLinkedList object.
 
@@ -71,7 +135,7 @@ ArrayLinkedList(NodePool<T, NUM_NODES> &p);
 -----------------------------------------------------------------------*/
 
 /***** Class copy constructor *****/
-ArrayLinkedList(const ArrayLinkedList &other);
+POOL_CONSTEXPR ArrayLinkedList(const ArrayLinkedList &other);
 /*----------------------------------------------------------------------
   Copy constructor for ArrayLinkedList.
 
@@ -79,8 +143,19 @@ ArrayLinkedList(const ArrayLinkedList &other);
   Postcondition: A new list object is created as a copy of the other list.
 -----------------------------------------------------------------------*/
 
+/***** Class view constructor *****/
+POOL_CONSTEXPR ArrayLinkedList(NodePool<T, NUM_NODES> &p, unsigned char tag, int headIdx);
+/*----------------------------------------------------------------------
+  Construct a list over an existing chain whose nodes already carry tag
+  (a tag reserved by someone else, e.g. in a shared pool).
+
+  Precondition:  Every node reachable from headIdx is tagged tag.
+  Postcondition: The list holds that chain in O(1); tag is not released by
+                 the destructor. Call detach() first to keep the nodes.
+-----------------------------------------------------------------------*/
+
 /***** Class destructor *****/
-~ArrayLinkedList();
+POOL_CONSTEXPR ~ArrayLinkedList();
 /*----------------------------------------------------------------------
   Destructor for ArrayLinkedList.
 
@@ -89,7 +164,7 @@ ArrayLinkedList(const ArrayLinkedList &other);
 -----------------------------------------------------------------------*/
 
 /***** isEmpty operation *****/
-bool isEmpty() const;
+POOL_CONSTEXPR bool isEmpty() const;
 /*----------------------------------------------------------------------
   Check if the list is empty.
 
@@ -98,7 +173,7 @@ bool isEmpty() const;
 -----------------------------------------------------------------------*/
 
 /***** size operation *****/
-int size() const;
+POOL_CONSTEXPR int size() const;
 /*----------------------------------------------------------------------
   Get the number of elements in the list.
 
@@ -107,7 +182,7 @@ int size() const;
 -----------------------------------------------------------------------*/
 
 /***** clear operation *****/
-void clear();
+POOL_CONSTEXPR void clear();
 /*----------------------------------------------------------------------
   Remove all elements from the list.
 
@@ -125,52 +200,57 @@ void display(std::ostream &os = std::cout) const;
 -----------------------------------------------------------------------*/
 
 /***** Insert Operations *****/
-void insertFront(const T &value);
+POOL_CONSTEXPR NodeHandle insertFront(const T &value);
 /*----------------------------------------------------------------------
   Insert at front, with full-pool handling.
 
   Precondition:  None.
-  Postcondition: A node containing `value` is allocated at head.
-                 If pool is full, prompts user to delete then retries.
+  Postcondition: A node containing `value` is allocated at head and its
+                 handle returned. If pool is full, prompts user to delete
+                 then retries (null handle if that fails).
 -----------------------------------------------------------------------*/
 
-void insertBack(const T &value);
+POOL_CONSTEXPR NodeHandle insertBack(const T &value);
 /*----------------------------------------------------------------------
   Insert at back, with full-pool handling.
 
   Precondition:  None.
-  Postcondition: A node containing `value` is allocated at tail.
-                 If pool is full, prompts user to delete then retries.
+  Postcondition: A node containing `value` is allocated at tail and its
+                 handle returned. If pool is full, prompts user to delete
+                 then retries (null handle if that fails).
 -----------------------------------------------------------------------*/
 
-bool insertAfter(const T &key, const T &value);
+template <typename K = T>
+POOL_CONSTEXPR NodeHandle insertAfter(const K &key, const T &value);
 /*----------------------------------------------------------------------
   Insert a new element after the first occurrence of a key.
 
   Precondition:  Key must exist in the list.
   Postcondition: A new node with `value` is linked immediately after key;
-                 returns true on success, false if key not found.
+                 returns its handle, or a null handle if key not found.
 -----------------------------------------------------------------------*/
 
-bool insertBefore(const T &key, const T &value);
+template <typename K = T>
+POOL_CONSTEXPR NodeHandle insertBefore(const K &key, const T &value);
 /*----------------------------------------------------------------------
   Insert a new element before the first occurrence of a key.
 
   Precondition:  List not empty, key exists.
   Postcondition: A new node with `value` is linked immediately before key;
-                 returns true on success, false if key not found.
+                 returns its handle, or a null handle if key not found.
 -----------------------------------------------------------------------*/
 
-bool insertAt(int position, const T &value);
+POOL_CONSTEXPR NodeHandle insertAt(int position, const T &value);
 /*----------------------------------------------------------------------
   Insert a new element at the specified index.
 
   Precondition:  Position is valid (0 <= position <= size()).
   Postcondition: If slot free, it’s acquired and appended; if full, prompts
-                 user to delete at that slot then retries; returns true on success.
+                 user to delete at that slot then retries; returns the
+                 node's handle, or a null handle on failure.
 -----------------------------------------------------------------------*/
 
-bool insertAtPosition(int position, const T &value);
+POOL_CONSTEXPR NodeHandle insertAtPosition(int position, const T &value);
 /*----------------------------------------------------------------------
   Same as insertAt — retained for compatibility.
 
@@ -178,7 +258,7 @@ bool insertAtPosition(int position, const T &value);
   Postcondition: Value is inserted at the given position.
 -----------------------------------------------------------------------*/
 
-bool insertSorted(const T &value);
+POOL_CONSTEXPR NodeHandle insertSorted(const T &value);
 /*----------------------------------------------------------------------
   Insert value while keeping list in ascending order.
 
@@ -186,7 +266,7 @@ bool insertSorted(const T &value);
   Postcondition: Value is inserted in correct position to maintain order.   
 -----------------------------------------------------------------------*/
 
-bool insertSortedDescending(const T &value);
+POOL_CONSTEXPR NodeHandle insertSortedDescending(const T &value);
 /*----------------------------------------------------------------------
   Insert value while keeping list in descending order.
 
@@ -195,7 +275,7 @@ bool insertSortedDescending(const T &value);
 -----------------------------------------------------------------------*/
 
 /***** Remove Operations *****/
-bool deleteFront();
+POOL_CONSTEXPR bool deleteFront();
 /*----------------------------------------------------------------------
   Remove the element at the front of the list.
 
@@ -205,7 +285,7 @@ bool deleteFront();
                  head advanced to next; returns true.
 -----------------------------------------------------------------------*/
 
-bool deleteBack();
+POOL_CONSTEXPR bool deleteBack();
 /*----------------------------------------------------------------------
   Remove the element at the end of the list.
 
@@ -215,7 +295,7 @@ bool deleteBack();
                  the new last node’s `next == NULL_INDEX`; returns true.
 -----------------------------------------------------------------------*/
 
-bool removeSlot(int slotIdx);
+POOL_CONSTEXPR bool removeSlot(int slotIdx);
 /*----------------------------------------------------------------------
   Remove a node at a specific index.
 
@@ -224,7 +304,8 @@ bool removeSlot(int slotIdx);
                  returned to the pool; returns true, else false.
 -----------------------------------------------------------------------*/
 
-bool removeValue(const T &value);
+template <typename K = T>
+POOL_CONSTEXPR bool removeValue(const K &value);
 /*----------------------------------------------------------------------
   Remove the first occurrence of the value from the list.
 
@@ -232,7 +313,8 @@ bool removeValue(const T &value);
   Postcondition: The value is removed from the list.
 -----------------------------------------------------------------------*/
 
-bool removeAllOccurrences(const T &value);
+template <typename K = T>
+POOL_CONSTEXPR bool removeAllOccurrences(const K &value);
 /*----------------------------------------------------------------------
   Remove all occurrences of a value from the list.
 
@@ -240,7 +322,8 @@ bool removeAllOccurrences(const T &value);
   Postcondition: All matching elements are removed.
 -----------------------------------------------------------------------*/
 
-bool removeBefore(const T &key);
+template <typename K = T>
+POOL_CONSTEXPR bool removeBefore(const K &key);
 /*----------------------------------------------------------------------
   Remove the node before the first occurrence of the key.
 
@@ -248,7 +331,8 @@ bool removeBefore(const T &key);
   Postcondition: The node before the key is removed.
 -----------------------------------------------------------------------*/
 
-bool removeAfter(const T &key);
+template <typename K = T>
+POOL_CONSTEXPR bool removeAfter(const K &key);
 /*----------------------------------------------------------------------
   Remove the node after the first occurrence of the key.
 
@@ -256,7 +340,30 @@ bool removeAfter(const T &key);
   Postcondition: The node after the key is removed.
 -----------------------------------------------------------------------*/
 
-void removeDuplicates();
+template <typename Pred>
+POOL_CONSTEXPR int eraseIf(Pred pred);
+/*----------------------------------------------------------------------
+  Remove every element for which pred(value) is true, in one pass.
+
+  Precondition:  pred does not modify the list.
+  Postcondition: Matching nodes are unlinked in order and released to the
+                 pool as one chain; returns the number removed. If pred
+                 throws, the elements matched so far are removed (their
+                 nodes released), the rest stay, and the exception
+                 propagates.
+-----------------------------------------------------------------------*/
+
+template <typename Pred>
+POOL_CONSTEXPR int retainIf(Pred pred);
+/*----------------------------------------------------------------------
+  Keep only the elements for which pred(value) is true.
+
+  Precondition:  pred does not modify the list.
+  Postcondition: Same as eraseIf with the negated predicate; returns the
+                 number removed.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR void removeDuplicates();
 /*----------------------------------------------------------------------
   Remove all duplicate elements from the list.
 
@@ -265,7 +372,7 @@ void removeDuplicates();
 -----------------------------------------------------------------------*/
 
 /***** Sorting Operations *****/
-void sortAscending();
+POOL_CONSTEXPR void sortAscending();
 /*----------------------------------------------------------------------
   Sort the list in ascending (smallest to largest) order.
 
@@ -273,7 +380,7 @@ void sortAscending();
   Postcondition: The list is sorted in ascending order.
 -----------------------------------------------------------------------*/
 
-void sortDescending();
+POOL_CONSTEXPR void sortDescending();
 /*----------------------------------------------------------------------
   Sort the list in descending (largest to smallest) order.
 
@@ -283,15 +390,60 @@ void sortDescending();
 
 /***** Other Operations *****/
 
-int find(const T &value) const;
+template <typename K = T>
+POOL_CONSTEXPR int find(const K &value) const;
 /*----------------------------------------------------------------------
   Find the index of a given value in the list.
 
   Precondition:  None
   Postcondition: Returns index of the value or -1 if not found.
+
+  Like every key-based operation (insertAfter/insertBefore, removeValue,
+  removeAllOccurrences, removeAfter/removeBefore, contains, count), the key
+  may be any type K comparable with T via ==, e.g. a const char* or
+  std::string_view for a list of std::string, so no T is constructed.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR bool contains(const T &value) const;
+/*----------------------------------------------------------------------
+  Check whether the list holds a value.
+
+  Precondition:  None
+  Postcondition: Returns true if found. For int/unsigned/float payloads
+                 this is a vectorized scan of the pool slots tagged with
+                 this list, with no index chasing.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR int count(const T &value) const;
+/*----------------------------------------------------------------------
+  Count the occurrences of a value.
+
+  Precondition:  None
+  Postcondition: Returns the number of matching elements (vectorized
+                 pool scan when available, as for contains).
+-----------------------------------------------------------------------*/
+
+template <typename K>
+POOL_CONSTEXPR bool contains(const K &key) const;
+template <typename K>
+POOL_CONSTEXPR int count(const K &key) const;
+/*----------------------------------------------------------------------
+  Heterogeneous contains / count for keys of another type than T.
+
+  Precondition:  pool data == key is well-formed.
+  Postcondition: As above, by walking the list.
+-----------------------------------------------------------------------*/
+
+std::vector<int> findAll(const T &value) const;
+/*----------------------------------------------------------------------
+  Collect the pool slots of every occurrence of a value.
+
+  Precondition:  None
+  Postcondition: Returns the slot indices (not positions) holding value,
+                 in increasing slot order rather than list order.
 -----------------------------------------------------------------------*/
 
-T &getAt(int position) const;
+POOL_CONSTEXPR T &getAt(int position) const;
 /*----------------------------------------------------------------------
   Get a reference to the element at the given position.
 
@@ -299,7 +451,184 @@ T &getAt(int position) const;
   Postcondition: Returns a reference to the element.
 -----------------------------------------------------------------------*/
 
-void reverse();
+/***** Handle operations *****/
+POOL_CONSTEXPR bool holds(NodeHandle h) const;
+/*----------------------------------------------------------------------
+  Check that a handle still refers to a node of this list.
+
+  Precondition:  None
+  Postcondition: False for a null or stale handle (its node was released)
+                 or another list's node. O(1) unless the list shares
+                 SHARED_OWNER, which needs a walk.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR T &get(NodeHandle h) const;
+/*----------------------------------------------------------------------
+  Precondition:  holds(h).
+  Postcondition: Returns a reference to the element of h in O(1).
+  Throws: std::invalid_argument if h is null, stale or not in this list.
+-----------------------------------------------------------------------*/
+
+template <typename K = T>
+POOL_CONSTEXPR NodeHandle findHandle(const K &key) const;
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the handle of the first element equal to key,
+                 or a null handle.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR NodeHandle insertAfter(NodeHandle h, const T &value);
+/*----------------------------------------------------------------------
+  Insert value right after the node of h, in O(1).
+
+  Precondition:  None
+  Postcondition: Returns the new node's handle; a null handle (nothing
+                 changed) if h fails holds(h) or the pool is full — this
+                 form does not prompt.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR bool erase(NodeHandle h);
+/*----------------------------------------------------------------------
+  Remove the node of h.
+
+  Precondition:  None
+  Postcondition: Returns false (nothing changed) if h fails holds(h);
+                 otherwise the node is unlinked and released, so h and
+                 its copies go stale. O(1) to validate, then a walk to the
+                 predecessor (none for the head).
+-----------------------------------------------------------------------*/
+
+/***** Cursor class *****/
+class Cursor
+{
+public:
+    POOL_CONSTEXPR explicit Cursor(ArrayLinkedList &l);
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: The cursor is on the first element (at the end for
+                     an empty list).
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR bool atEnd() const;
+    POOL_CONSTEXPR int slot() const;
+    POOL_CONSTEXPR NodeHandle handle() const;
+    POOL_CONSTEXPR T &value() const;
+    /*----------------------------------------------------------------------
+      Precondition:  value() only when !atEnd().
+      Postcondition: slot() is the current pool index (NULL_INDEX at the
+                     end); handle() is null at the end.
+      Throws: std::out_of_range from value() at the end.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR bool advance();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Moves to the next element; false (no move) at the end.
+    -----------------------------------------------------------------------*/
+
+    template <typename K = T>
+    POOL_CONSTEXPR bool seek(const K &key);
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Moves forward from the current element (included) to
+                     the first one equal to key and returns true; at the
+                     end and false if there is none.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR NodeHandle insertBefore(const T &value);
+    /*----------------------------------------------------------------------
+      Insert value before the current element (at the end: append).
+
+      Precondition:  None
+      Postcondition: The cursor stays on the same element, so repeated
+                     calls build a run in order. Returns the new node's
+                     handle; null (nothing changed) if the pool is full.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR NodeHandle insertAfter(const T &value);
+    /*----------------------------------------------------------------------
+      Insert value after the current element.
+
+      Precondition:  None
+      Postcondition: The cursor does not move. Returns the new node's
+                     handle; null (nothing changed) at the end or if the
+                     pool is full.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR bool erase();
+    /*----------------------------------------------------------------------
+      Remove the current element.
+
+      Precondition:  None
+      Postcondition: The node is released and the cursor is on the next
+                     element; false (nothing changed) at the end.
+    -----------------------------------------------------------------------*/
+
+private:
+    ArrayLinkedList *list;
+    int prev; // NULL_INDEX when cur is the head
+    int cur;  // NULL_INDEX at the end
+};
+/*----------------------------------------------------------------------
+  A position in the list that remembers its predecessor, so edits at the
+  position are O(1) and filter- or merge-like passes need one traversal.
+  Every operation is O(1) except seek. Changing the list other than
+  through this cursor invalidates it.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR Cursor cursor();
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns a cursor on the first element.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR NodePool<T, NUM_NODES> &getPool() const;
+POOL_CONSTEXPR int getHead() const;
+POOL_CONSTEXPR unsigned char getOwnerTag() const;
+/*----------------------------------------------------------------------
+  Raw access for algorithms that work on pool slots directly
+  (ParallelList.h and friends).
+
+  Precondition:  None
+  Postcondition: Returns the pool, the head slot (NULL_INDEX when empty)
+                 and the owner tag carried by this list's slots
+                 (SHARED_OWNER if the pool ran out of tags).
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR void attach(int headIdx);
+/*----------------------------------------------------------------------
+  Adopt a chain of used pool nodes as this list's contents (used when a
+  pool is restored from a snapshot, file or shared memory).
+
+  Precondition:  The list is empty; headIdx is NULL_INDEX or the first
+                 node of a NULL_INDEX-terminated chain of used nodes.
+  Postcondition: head == headIdx and every node of the chain carries this
+                 list's owner tag.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR int detach();
+/*----------------------------------------------------------------------
+  Give up the list's nodes without returning them to the pool.
+
+  Precondition:  None
+  Postcondition: Returns the former head; the list is empty and the
+                 nodes stay used (e.g. persisted for a later attach).
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR void appendChain(int first, int last);
+/*----------------------------------------------------------------------
+  Link a chain built directly in the pool (e.g. by a bulk loader) after
+  the last element.
+
+  Precondition:  first..last are used nodes linked by next, already
+                 carrying this list's owner tag and on no other list
+                 (first == NULL_INDEX: nothing to append).
+  Postcondition: The chain follows the former tail and last ends the
+                 list; one walk to the tail and no pass over the new
+                 nodes (they are not re-tagged).
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR void reverse();
 /*----------------------------------------------------------------------
   Reverse the order of the list.
 
@@ -307,8 +636,51 @@ void reverse();
   Postcondition: The order of elements is reversed.
 -----------------------------------------------------------------------*/
 
+/***** Sorted Combine Operations *****/
+POOL_CONSTEXPR bool merge(ArrayLinkedList &other);
+/*----------------------------------------------------------------------
+  Merge another ascending list into this one in a single pass.
+
+  Precondition:  Both lists are sorted in ascending order (insertSorted).
+  Postcondition: This list holds every element of both lists in ascending
+                 order (stable: equal values from this list come first);
+                 other is empty. Nodes are relinked when both lists share
+                 a pool, otherwise copied and released from other's pool.
+                 Returns false (nothing changed) if this pool cannot
+                 hold the copied nodes.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR bool setUnion(ArrayLinkedList &other);
+/*----------------------------------------------------------------------
+  Replace this list with the sorted union of this list and other.
+
+  Precondition:  Both lists are sorted in ascending order.
+  Postcondition: Same multiset rules as std::set_union (a value kept
+                 max(countA, countB) times); other is empty and its
+                 unused nodes are released. Returns false (nothing
+                 changed) if this pool cannot hold the copied nodes.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR bool setIntersection(ArrayLinkedList &other);
+/*----------------------------------------------------------------------
+  Replace this list with the sorted intersection of this list and other.
+
+  Precondition:  Both lists are sorted in ascending order.
+  Postcondition: Same multiset rules as std::set_intersection; other is
+                 empty and all dropped nodes are released. Returns true.
+-----------------------------------------------------------------------*/
+
+POOL_CONSTEXPR bool setDifference(ArrayLinkedList &other);
+/*----------------------------------------------------------------------
+  Remove from this list every value that also appears in other.
+
+  Precondition:  Both lists are sorted in ascending order.
+  Postcondition: Same multiset rules as std::set_difference; other is
+                 empty and all dropped nodes are released. Returns true.
+-----------------------------------------------------------------------*/
+
 /***** Operator Overloads *****/
-ArrayLinkedList &operator+=(const ArrayLinkedList &rhs);
+POOL_CONSTEXPR ArrayLinkedList &operator+=(const ArrayLinkedList &rhs);
 /*----------------------------------------------------------------------
   Append the contents of rhs to this list.
 
@@ -316,7 +688,7 @@ ArrayLinkedList &operator+=(const ArrayLinkedList &rhs);
   Postcondition: This list includes all elements from rhs.
 -----------------------------------------------------------------------*/
 
-ArrayLinkedList operator+(const ArrayLinkedList &rhs) const;
+POOL_CONSTEXPR ArrayLinkedList operator+(const ArrayLinkedList &rhs) const;
 /*----------------------------------------------------------------------
   Return a new list that is the concatenation of this list and rhs.
 
@@ -324,7 +696,7 @@ ArrayLinkedList operator+(const ArrayLinkedList &rhs) const;
   Postcondition: New list includes all elements from both.
 -----------------------------------------------------------------------*/
 
-ArrayLinkedList &operator=(const ArrayLinkedList &other);
+POOL_CONSTEXPR ArrayLinkedList &operator=(const ArrayLinkedList &other);
 /*----------------------------------------------------------------------
   Assignment operator for ArrayLinkedList.
 
@@ -334,66 +706,121 @@ ArrayLinkedList &operator=(const ArrayLinkedList &other);
 
 
 private:
+    /***** Combine helpers *****/
+    enum CombineMode
+    {
+        COMBINE_MERGE,
+        COMBINE_UNION,
+        COMBINE_INTERSECTION,
+        COMBINE_DIFFERENCE
+    };
+
+    POOL_CONSTEXPR bool combineSorted(ArrayLinkedList &other, CombineMode mode);
+    /*----------------------------------------------------------------------
+      Shared single-pass walk behind merge and the set operations.
+
+      Precondition:  Both lists are sorted in ascending order.
+      Postcondition: This list holds the combined result; other is empty.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR bool useSlotScan() const;
+    /*----------------------------------------------------------------------
+      Decide whether an order-independent query should scan the pool
+      slots instead of walking the list.
+
+      Precondition:  None
+      Postcondition: True when T has a vector kernel, this list has its own
+                     owner tag, and the pool is dense enough to pay off.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR int scanCount(const T &value) const;
+    template <typename K>
+    POOL_CONSTEXPR int scanCount(const K &) const { return -1; }
+    /*----------------------------------------------------------------------
+      Number of matches from a pool slot scan, or -1 when no scan applies
+      (sparse pool, shared owner tag, or a key that is not a T).
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR int adoptNode(ArrayLinkedList &other, int idx);
+    /*----------------------------------------------------------------------
+      Move node idx of other into this list's pool.
+
+      Precondition:  idx was unlinked from other; if the pools differ, this
+                     pool has a free node.
+      Postcondition: Returns idx itself when the pools are shared; otherwise
+                     returns a new node holding a copy, and idx is released.
+    -----------------------------------------------------------------------*/
+
     /******** Data Members ********/
     NodePool<T, NUM_NODES> &pool; // node pool reference
     int head;                     // head index of the list
+    unsigned char ownerTag;       // tag of this list's nodes in the pool
+    bool ownsTag;                 // tag was registered by this list
 
 }; //--- end of ArrayLinkedList class
 
 /***** Implementation Section *****/
 
 template <typename T, int N>
-ArrayLinkedList<T, N>::ArrayLinkedList(NodePool<T, N> &p)
-    : pool(p), head(NULL_INDEX) {}
+POOL_CONSTEXPR ArrayLinkedList<T, N>::ArrayLinkedList(NodePool<T, N> &p)
+    : pool(p), head(NULL_INDEX), ownerTag(p.registerOwner()), ownsTag(true) {}
+
+template <typename T, int N>
+POOL_CONSTEXPR ArrayLinkedList<T, N>::ArrayLinkedList(NodePool<T, N> &p, unsigned char tag, int headIdx)
+    : pool(p), head(headIdx), ownerTag(tag), ownsTag(false) {}
 
 template <typename T, int N>
-ArrayLinkedList<T, N>::ArrayLinkedList(const ArrayLinkedList &other)
-    : pool(other.pool), head(NULL_INDEX)
+POOL_CONSTEXPR ArrayLinkedList<T, N>::ArrayLinkedList(const ArrayLinkedList &other)
+    : pool(other.pool), head(NULL_INDEX), ownerTag(other.pool.registerOwner()), ownsTag(true)
 {
-    for (int idx = other.head; idx != NULL_INDEX; idx = other.pool[idx].next)
+    LIST_OP(LOP_COPY);
+    for (int idx = other.head; idx != NULL_INDEX; idx = LIST_NEXT(other.pool, idx))
     {
-        insertBack(other.pool[idx].data);
+        insertBack(other.pool.node(idx).data);
     }
 }
 template <typename T, int N>
-ArrayLinkedList<T, N> &ArrayLinkedList<T, N>::operator=(const ArrayLinkedList &other)
+POOL_CONSTEXPR ArrayLinkedList<T, N> &ArrayLinkedList<T, N>::operator=(const ArrayLinkedList &other)
 {
+    LIST_OP(LOP_ASSIGN);
     if (this != &other)
     {
         clear();
-        for (int idx = other.head; idx != NULL_INDEX; idx = other.pool[idx].next)
+        for (int idx = other.head; idx != NULL_INDEX; idx = LIST_NEXT(other.pool, idx))
         {
-            insertBack(other.pool[idx].data);
+            insertBack(other.pool.node(idx).data);
         }
     }
     return *this;
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::isEmpty() const
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::isEmpty() const
 {
     return head == NULL_INDEX;
 }
 
 template <typename T, int NUM_NODES>
-int ArrayLinkedList<T, NUM_NODES>::size() const
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::size() const
 {
+    LIST_OP(LOP_SIZE);
     int count = 0, ptr = head;
     while (ptr != NULL_INDEX)
     {
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
         ++count;
     }
     return count;
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::clear()
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::clear()
 {
+    LIST_OP(LOP_CLEAR);
     int ptr = head;
     while (ptr != NULL_INDEX)
     {
-        int next = pool[ptr].next;
+        int next = LIST_NEXT(pool, ptr);
         pool.deleteNode(ptr);
         ptr = next;
     }
@@ -404,6 +831,7 @@ template <typename T, int NUM_NODES>
 
 void ArrayLinkedList<T, NUM_NODES>::display(std::ostream &os) const
 {
+    LIST_OP(LOP_DISPLAY);
     os << "[";
     int ptr = head;
 
@@ -415,8 +843,8 @@ void ArrayLinkedList<T, NUM_NODES>::display(std::ostream &os) const
     {
         while (ptr != NULL_INDEX)
         {
-            os << pool[ptr].data;
-            int next = pool[ptr].next;
+            os << pool.node(ptr).data;
+            int next = LIST_NEXT(pool, ptr);
             if (next != NULL_INDEX)
             {
                 os << ", ";
@@ -429,34 +857,38 @@ void ArrayLinkedList<T, NUM_NODES>::display(std::ostream &os) const
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::removeSlot(int slotIdx)
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::removeSlot(int slotIdx)
 {
+    LIST_OP(LOP_REMOVE_SLOT);
 
     if (slotIdx < 0 || slotIdx >= NUM_NODES)
         return false;
+    if (ownerTag != SHARED_OWNER && pool.ownerOf(slotIdx) != ownerTag)
+        return false; // not one of this list's nodes, no walk needed
 
     int ptr = head, prev = NULL_INDEX;
     while (ptr != NULL_INDEX && ptr != slotIdx)
     {
         prev = ptr;
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
     }
     if (ptr != slotIdx)
         return false;
 
     if (prev == NULL_INDEX)
-        head = pool[ptr].next;
+        head = pool.node(ptr).next;
     else
-        pool[prev].next = pool[ptr].next;
+        pool.node(prev).next = pool.node(ptr).next;
 
     pool.deleteNode(ptr);
     return true;
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::insertFront(const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertFront(const T &value)
 {
-    int nodeIdx = pool.newNode();
+    LIST_OP(LOP_INSERT_FRONT);
+    int nodeIdx = pool.newNode(ownerTag);
 if (nodeIdx == NULL_INDEX)
 {
     bool deleted = false;
@@ -479,7 +911,7 @@ if (nodeIdx == NULL_INDEX)
         {
             std::cout << "Value to delete: ";
             T delVal;
-            std::getline(std::cin, delVal);
+            readValue(std::cin, delVal);
             deleted = removeValue(delVal);
         }
         else
@@ -494,24 +926,26 @@ if (nodeIdx == NULL_INDEX)
         }
     }
 
-    nodeIdx = pool.newNode();
+    nodeIdx = pool.newNode(ownerTag);
     if (nodeIdx == NULL_INDEX)
     {
         std::cout << "Still no free node, aborting insertFront.\n";
-        return;
+        return NodeHandle();
     }
 }
 
 
-    pool[nodeIdx].data = value;
-    pool[nodeIdx].next = head;
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = head;
     head = nodeIdx;
+    return pool.handleOf(nodeIdx);
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
 {
-    int nodeIdx = pool.newNode();
+    LIST_OP(LOP_INSERT_BACK);
+    int nodeIdx = pool.newNode(ownerTag);
     if (nodeIdx == NULL_INDEX)
     {
         bool deleted = false;
@@ -534,7 +968,7 @@ void ArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
             {
                 std::cout << "Value to delete: ";
                 T delVal;
-                std::getline(std::cin, delVal);
+                readValue(std::cin, delVal);
                 deleted = removeValue(delVal);
             }
             else
@@ -549,15 +983,15 @@ void ArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
             }
         }
     
-        nodeIdx = pool.newNode();
+        nodeIdx = pool.newNode(ownerTag);
         if (nodeIdx == NULL_INDEX)
         {
             std::cout << "Still no free node, aborting insertBack.\n";
-            return;
+            return NodeHandle();
         }
     }
-    pool[nodeIdx].data = value;
-    pool[nodeIdx].next = NULL_INDEX;
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = NULL_INDEX;
     if (isEmpty())
     {
         head = nodeIdx;
@@ -565,20 +999,23 @@ void ArrayLinkedList<T, NUM_NODES>::insertBack(const T &value)
     else
     {
         int ptr = head;
-        while (pool[ptr].next != NULL_INDEX)
-            ptr = pool[ptr].next;
-        pool[ptr].next = nodeIdx;
+        while (pool.node(ptr).next != NULL_INDEX)
+            ptr = LIST_NEXT(pool, ptr);
+        pool.node(ptr).next = nodeIdx;
     }
+    return pool.handleOf(nodeIdx);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertBefore(const T &key, const T &value)
+template <typename K>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertBefore(const K &key, const T &value)
 {
+    LIST_OP(LOP_INSERT_BEFORE);
 
     if (head == NULL_INDEX)
-        return false;
+        return NodeHandle();
 
-    int newIdx = pool.newNode();
+    int newIdx = pool.newNode(ownerTag);
     if (newIdx == NULL_INDEX)
     {
         bool deleted = false;
@@ -603,7 +1040,7 @@ bool ArrayLinkedList<T, NUM_NODES>::insertBefore(const T &key, const T &value)
         {
             std::cout << "Value to delete: ";
             T v;
-            std::getline(std::cin, v);
+            readValue(std::cin, v);
             deleted = removeValue(v);
         }
         else
@@ -617,45 +1054,50 @@ bool ArrayLinkedList<T, NUM_NODES>::insertBefore(const T &key, const T &value)
                 std::cout << "Deletion failed. Try again.\n";
             }
         }
-        newIdx = pool.newNode();
+        newIdx = pool.newNode(ownerTag);
         if (newIdx == NULL_INDEX)
         {
             std::cout << "Still no free node, aborting insertBefore.\n";
-            return false;
+            return NodeHandle();
         }
     }
 
     int ptr = head, prev = NULL_INDEX;
-    while (ptr != NULL_INDEX && pool[ptr].data != key)
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == key))
     {
         prev = ptr;
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
     }
 
     if (ptr == NULL_INDEX)
-        return false;
+    {
+        pool.deleteNode(newIdx); // key not found: give the node back
+        return NodeHandle();
+    }
 
-    pool[newIdx].data = value;
-    pool[newIdx].next = ptr;
+    pool.node(newIdx).data = value;
+    pool.node(newIdx).next = ptr;
 
     if (prev == NULL_INDEX)
         head = newIdx;
     else
-        pool[prev].next = newIdx;
+        pool.node(prev).next = newIdx;
 
-    return true;
+    return pool.handleOf(newIdx);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
+template <typename K>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertAfter(const K &key, const T &value)
 {
+    LIST_OP(LOP_INSERT_AFTER);
     int ptr = head;
-    while (ptr != NULL_INDEX && pool[ptr].data != key)
-        ptr = pool[ptr].next;
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == key))
+        ptr = LIST_NEXT(pool, ptr);
     if (ptr == NULL_INDEX)
-        return false;
+        return NodeHandle();
     
-    int nodeIdx = pool.newNode();
+    int nodeIdx = pool.newNode(ownerTag);
     if (nodeIdx == NULL_INDEX)
     {
         bool deleted = false;
@@ -682,7 +1124,7 @@ bool ArrayLinkedList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
             {
                 std::cout << "Enter value to delete: ";
                 T delVal;
-                std::getline(std::cin, delVal);
+                readValue(std::cin, delVal);
                 deleted = removeValue(delVal);
             }
             else
@@ -697,45 +1139,53 @@ bool ArrayLinkedList<T, NUM_NODES>::insertAfter(const T &key, const T &value)
             }
         }
     
-        nodeIdx = pool.newNode();
+        nodeIdx = pool.newNode(ownerTag);
         if (nodeIdx == NULL_INDEX)
         {
             std::cout << "Unexpected error: still no free node.\n";
-            return false;
+            return NodeHandle();
         }
     }
     
-    pool[nodeIdx].data = value;
-    pool[nodeIdx].next = pool[ptr].next;
-    pool[ptr].next = nodeIdx;
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = pool.node(ptr).next;
+    pool.node(ptr).next = nodeIdx;
 
-    return true;
+    return pool.handleOf(nodeIdx);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::removeAllOccurrences(const T &value)
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::removeAllOccurrences(const K &value)
 {
+    LIST_OP(LOP_REMOVE_ALL);
+    // With a slot scan the walk can stop after the last match
+    int remaining = scanCount(value);
+    if (remaining == 0)
+        return false;
+
     bool removed = false;
     int ptr = head, prev = NULL_INDEX;
 
-    while (ptr != NULL_INDEX)
+    while (ptr != NULL_INDEX && remaining != 0)
     {
-        if (pool[ptr].data == value)
+        if (pool.node(ptr).data == value)
         {
             if (prev == NULL_INDEX)
-                head = pool[ptr].next;
+                head = pool.node(ptr).next;
             else
-                pool[prev].next = pool[ptr].next;
+                pool.node(prev).next = pool.node(ptr).next;
 
             int toDelete = ptr;
-            ptr = pool[ptr].next;
+            ptr = LIST_NEXT(pool, ptr);
             pool.deleteNode(toDelete);
             removed = true;
+            --remaining;
         }
         else
         {
             prev = ptr;
-            ptr = pool[ptr].next;
+            ptr = LIST_NEXT(pool, ptr);
         }
     }
 
@@ -743,11 +1193,12 @@ bool ArrayLinkedList<T, NUM_NODES>::removeAllOccurrences(const T &value)
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertAt(int arrayIndex, const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertAt(int arrayIndex, const T &value)
 {
+    LIST_OP(LOP_INSERT_AT);
 
     if (arrayIndex < 0 || arrayIndex >= NUM_NODES)
-        return false;
+        return NodeHandle();
 
     if (pool.freeCount() == 0)
     {
@@ -756,20 +1207,20 @@ bool ArrayLinkedList<T, NUM_NODES>::insertAt(int arrayIndex, const T &value)
         std::cin >> c;
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         if (c != 'y' && c != 'Y')
-            return false;
+            return NodeHandle();
 
         if (!this->removeSlot(arrayIndex))
         {
             std::cout << "Deletion failed\n";
-            return false;
+            return NodeHandle();
         }
     }
 
-    if (!pool.acquire(arrayIndex))
-        return false;
+    if (!pool.acquire(arrayIndex, ownerTag))
+        return NodeHandle();
 
-    pool[arrayIndex].data = value;
-    pool[arrayIndex].next = NULL_INDEX;
+    pool.node(arrayIndex).data = value;
+    pool.node(arrayIndex).next = NULL_INDEX;
 
     if (head == NULL_INDEX)
     {
@@ -778,86 +1229,92 @@ bool ArrayLinkedList<T, NUM_NODES>::insertAt(int arrayIndex, const T &value)
     else
     {
         int ptr = head;
-        while (pool[ptr].next != NULL_INDEX)
-            ptr = pool[ptr].next;
-        pool[ptr].next = arrayIndex;
+        while (pool.node(ptr).next != NULL_INDEX)
+            ptr = LIST_NEXT(pool, ptr);
+        pool.node(ptr).next = arrayIndex;
     }
 
-    return true;
+    return pool.handleOf(arrayIndex);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::removeValue(const T &value)
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::removeValue(const K &value)
 
 {
+    LIST_OP(LOP_REMOVE_VALUE);
     int ptr = head, prev = NULL_INDEX;
-    while (ptr != NULL_INDEX && pool[ptr].data != value)
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == value))
     {
         prev = ptr;
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
     }
     if (ptr == NULL_INDEX)
         return false;
     if (prev == NULL_INDEX)
-        head = pool[ptr].next;
+        head = pool.node(ptr).next;
     else
-        pool[prev].next = pool[ptr].next;
+        pool.node(prev).next = pool.node(ptr).next;
     pool.deleteNode(ptr);
     return true;
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::removeAfter(const T &key)
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::removeAfter(const K &key)
 {
+    LIST_OP(LOP_REMOVE_AFTER);
    
     int ptr = head;
-    while (ptr != NULL_INDEX && pool[ptr].data != key)
+    while (ptr != NULL_INDEX && !(pool.node(ptr).data == key))
     {
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
     }
   
-    if (ptr == NULL_INDEX || pool[ptr].next == NULL_INDEX)
+    if (ptr == NULL_INDEX || pool.node(ptr).next == NULL_INDEX)
     {
         return false;
     }
-    int toRemove = pool[ptr].next;
-    pool[ptr].next = pool[toRemove].next;
+    int toRemove = LIST_NEXT(pool, ptr);
+    pool.node(ptr).next = pool.node(toRemove).next;
    
     pool.deleteNode(toRemove);
     return true;
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::removeBefore(const T &key)
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::removeBefore(const K &key)
 {
+    LIST_OP(LOP_REMOVE_BEFORE);
 
-    if (head == NULL_INDEX || pool[head].data == key)
+    if (head == NULL_INDEX || pool.node(head).data == key)
     {
         return false;
     }
 
-    int second = pool[head].next;
-    if (second != NULL_INDEX && pool[second].data == key)
+    int second = LIST_NEXT(pool, head);
+    if (second != NULL_INDEX && pool.node(second).data == key)
     {
         int toRemove = head;
-        head = pool[head].next;
+        head = pool.node(head).next;
         pool.deleteNode(toRemove);
         return true;
     }
 
     int prevPrev = head;
-    int prev = pool[head].next;
-    int curr = pool[prev].next;
-    while (curr != NULL_INDEX && pool[curr].data != key)
+    int prev = LIST_NEXT(pool, head);
+    int curr = LIST_NEXT(pool, prev);
+    while (curr != NULL_INDEX && !(pool.node(curr).data == key))
     {
         prevPrev = prev;
         prev = curr;
-        curr = pool[curr].next;
+        curr = LIST_NEXT(pool, curr);
     }
 
     if (curr != NULL_INDEX)
     {
-        pool[prevPrev].next = pool[prev].next;
+        pool.node(prevPrev).next = pool.node(prev).next;
         pool.deleteNode(prev);
         return true;
     }
@@ -865,57 +1322,381 @@ bool ArrayLinkedList<T, NUM_NODES>::removeBefore(const T &key)
 }
 
 template <typename T, int NUM_NODES>
-int ArrayLinkedList<T, NUM_NODES>::find(const T &value) const
+template <typename K>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::find(const K &value) const
 {
+    LIST_OP(LOP_FIND);
     int ptr = head, idx = 0;
     while (ptr != NULL_INDEX)
     {
-        if (pool[ptr].data == value)
+        if (pool.node(ptr).data == value)
             return idx;
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
         ++idx;
     }
     return -1;
 }
 
 template <typename T, int NUM_NODES>
-T &ArrayLinkedList<T, NUM_NODES>::getAt(int position) const
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::useSlotScan() const
+{
+#ifdef POOL_HAS_CONSTEXPR
+    if (std::is_constant_evaluated())
+        return false; // the SIMD kernels only run at runtime
+#endif
+    // A full slot scan costs NUM_NODES compares, so skip it for sparse pools
+    return SimdScanTraits<T>::vectorized && ownerTag != SHARED_OWNER &&
+           simdLevel() != SIMD_SCALAR && pool.usedCount() * 8 >= NUM_NODES;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::scanCount(const T &value) const
+{
+    return useSlotScan() ? simdCountMatches(pool, value, ownerTag) : -1;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::contains(const T &value) const
+{
+    LIST_OP(LOP_CONTAINS);
+    if (useSlotScan())
+        return !simdScanMatches(pool, value, ownerTag, [](int) { return false; });
+    return find(value) != -1;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::count(const T &value) const
+{
+    LIST_OP(LOP_COUNT);
+    if (useSlotScan())
+        return simdCountMatches(pool, value, ownerTag);
+
+    int matches = 0;
+    for (int ptr = head; ptr != NULL_INDEX; ptr = LIST_NEXT(pool, ptr))
+    {
+        if (pool.node(ptr).data == value)
+            ++matches;
+    }
+    return matches;
+}
+
+template <typename T, int NUM_NODES>
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::contains(const K &key) const
 {
+    LIST_OP(LOP_CONTAINS);
+    return find(key) != -1;
+}
+
+template <typename T, int NUM_NODES>
+template <typename K>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::count(const K &key) const
+{
+    LIST_OP(LOP_COUNT);
+    int matches = 0;
+    for (int ptr = head; ptr != NULL_INDEX; ptr = LIST_NEXT(pool, ptr))
+    {
+        if (pool.node(ptr).data == key)
+            ++matches;
+    }
+    return matches;
+}
+
+template <typename T, int NUM_NODES>
+std::vector<int> ArrayLinkedList<T, NUM_NODES>::findAll(const T &value) const
+{
+    LIST_OP(LOP_FIND_ALL);
+    std::vector<int> slots;
+    if (useSlotScan())
+    {
+        simdScanMatches(pool, value, ownerTag, [&slots](int slot) {
+            slots.push_back(slot);
+            return true;
+        });
+        return slots;
+    }
+
+    for (int ptr = head; ptr != NULL_INDEX; ptr = LIST_NEXT(pool, ptr))
+    {
+        if (pool.node(ptr).data == value)
+            slots.push_back(ptr);
+    }
+    std::sort(slots.begin(), slots.end());
+    return slots;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR T &ArrayLinkedList<T, NUM_NODES>::getAt(int position) const
+{
+    LIST_OP(LOP_GET_AT);
     if (position < 0 || position >= size())
         throw std::out_of_range("Position out of range");
     int ptr = head;
     for (int i = 0; i < position; ++i)
-        ptr = pool[ptr].next;
-    return pool[ptr].data;
+        ptr = LIST_NEXT(pool, ptr);
+    return pool.node(ptr).data;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::holds(NodeHandle h) const
+{
+    if (!pool.isLive(h))
+        return false;
+    if (ownerTag != SHARED_OWNER)
+        return pool.ownerOf(h.slot) == ownerTag;
+    for (int ptr = head; ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+        if (ptr == h.slot)
+            return true;
+    return false;
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::reverse()
+POOL_CONSTEXPR T &ArrayLinkedList<T, NUM_NODES>::get(NodeHandle h) const
 {
+    if (!holds(h))
+        throw std::invalid_argument("get: stale or foreign handle");
+    return pool.node(h.slot).data;
+}
+
+template <typename T, int NUM_NODES>
+template <typename K>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::findHandle(const K &key) const
+{
+    LIST_OP(LOP_FIND);
+    for (int ptr = head; ptr != NULL_INDEX; ptr = LIST_NEXT(pool, ptr))
+    {
+        if (pool.node(ptr).data == key)
+            return pool.handleOf(ptr);
+    }
+    return NodeHandle();
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertAfter(NodeHandle h, const T &value)
+{
+    LIST_OP(LOP_INSERT_AFTER);
+    if (!holds(h))
+        return NodeHandle();
+    int nodeIdx = pool.newNode(ownerTag);
+    if (nodeIdx == NULL_INDEX)
+        return NodeHandle();
+
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = pool.node(h.slot).next;
+    pool.node(h.slot).next = nodeIdx;
+    return pool.handleOf(nodeIdx);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::erase(NodeHandle h)
+{
+    LIST_OP(LOP_REMOVE_SLOT);
+    if (!holds(h))
+        return false;
+
+    if (head == h.slot)
+        head = pool.node(head).next;
+    else
+    {
+        int prev = head;
+        while (pool.node(prev).next != h.slot)
+            prev = LIST_NEXT(pool, prev);
+        pool.node(prev).next = pool.node(h.slot).next;
+    }
+    pool.deleteNode(h.slot);
+    return true;
+}
+
+/***** Cursor implementation *****/
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR ArrayLinkedList<T, NUM_NODES>::Cursor::Cursor(ArrayLinkedList &l)
+    : list(&l), prev(NULL_INDEX), cur(l.head) {}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR typename ArrayLinkedList<T, NUM_NODES>::Cursor ArrayLinkedList<T, NUM_NODES>::cursor()
+{
+    return Cursor(*this);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::Cursor::atEnd() const
+{
+    return cur == NULL_INDEX;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::Cursor::slot() const
+{
+    return cur;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::Cursor::handle() const
+{
+    return list->pool.handleOf(cur);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR T &ArrayLinkedList<T, NUM_NODES>::Cursor::value() const
+{
+    if (cur == NULL_INDEX)
+        throw std::out_of_range("Cursor::value at end");
+    return list->pool.node(cur).data;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::Cursor::advance()
+{
+    if (cur == NULL_INDEX)
+        return false;
+    prev = cur;
+    cur = list->pool.node(cur).next;
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+template <typename K>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::Cursor::seek(const K &key)
+{
+    while (cur != NULL_INDEX && !(list->pool.node(cur).data == key))
+        advance();
+    return cur != NULL_INDEX;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::Cursor::insertBefore(const T &value)
+{
+    NodePool<T, NUM_NODES> &pool = list->pool;
+    int nodeIdx = pool.newNode(list->ownerTag);
+    if (nodeIdx == NULL_INDEX)
+        return NodeHandle();
+
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = cur;
+    if (prev == NULL_INDEX)
+        list->head = nodeIdx;
+    else
+        pool.node(prev).next = nodeIdx;
+    prev = nodeIdx;
+    return pool.handleOf(nodeIdx);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::Cursor::insertAfter(const T &value)
+{
+    if (cur == NULL_INDEX)
+        return NodeHandle();
+    NodePool<T, NUM_NODES> &pool = list->pool;
+    int nodeIdx = pool.newNode(list->ownerTag);
+    if (nodeIdx == NULL_INDEX)
+        return NodeHandle();
+
+    pool.node(nodeIdx).data = value;
+    pool.node(nodeIdx).next = pool.node(cur).next;
+    pool.node(cur).next = nodeIdx;
+    return pool.handleOf(nodeIdx);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::Cursor::erase()
+{
+    if (cur == NULL_INDEX)
+        return false;
+    NodePool<T, NUM_NODES> &pool = list->pool;
+    int next = pool.node(cur).next;
+    if (prev == NULL_INDEX)
+        list->head = next;
+    else
+        pool.node(prev).next = next;
+    pool.deleteNode(cur);
+    cur = next;
+    return true;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodePool<T, NUM_NODES> &ArrayLinkedList<T, NUM_NODES>::getPool() const
+{
+    return pool;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::getHead() const
+{
+    return head;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR unsigned char ArrayLinkedList<T, NUM_NODES>::getOwnerTag() const
+{
+    return ownerTag;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::attach(int headIdx)
+{
+    LIST_OP(LOP_ATTACH);
+    if (head != NULL_INDEX)
+        throw std::logic_error("attach: list is not empty");
+    for (int ptr = headIdx; ptr != NULL_INDEX; ptr = LIST_NEXT(pool, ptr))
+        pool.setOwner(ptr, ownerTag);
+    head = headIdx;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::detach()
+{
+    int oldHead = head;
+    head = NULL_INDEX;
+    return oldHead;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::appendChain(int first, int last)
+{
+    LIST_OP(LOP_APPEND_CHAIN);
+    if (first == NULL_INDEX)
+        return;
+    pool.node(last).next = NULL_INDEX;
+    if (head == NULL_INDEX)
+    {
+        head = first;
+        return;
+    }
+    int tail = head;
+    while (pool.node(tail).next != NULL_INDEX)
+        tail = LIST_NEXT(pool, tail);
+    pool.node(tail).next = first;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::reverse()
+{
+    LIST_OP(LOP_REVERSE);
     int prev = NULL_INDEX;
     int curr = head;
     while (curr != NULL_INDEX)
     {
-        int next = pool[curr].next;
-        pool[curr].next = prev;
+        int next = LIST_NEXT(pool, curr);
+        pool.node(curr).next = prev;
         prev = curr;
         curr = next;
     }
     head = prev;
 }
 template <typename T, int N>
-ArrayLinkedList<T, N> &ArrayLinkedList<T, N>::operator+=(const ArrayLinkedList &rhs)
+POOL_CONSTEXPR ArrayLinkedList<T, N> &ArrayLinkedList<T, N>::operator+=(const ArrayLinkedList &rhs)
 {
+    LIST_OP(LOP_APPEND);
     int ptr = rhs.head;
     while (ptr != NULL_INDEX)
     {
-        insertBack(rhs.pool[ptr].data);
-        ptr = rhs.pool[ptr].next;
+        insertBack(rhs.pool.node(ptr).data);
+        ptr = LIST_NEXT(rhs.pool, ptr);
     }
     return *this;
 }
 template <typename T, int N>
-ArrayLinkedList<T, N> ArrayLinkedList<T, N>::operator+(const ArrayLinkedList &rhs) const
+POOL_CONSTEXPR ArrayLinkedList<T, N> ArrayLinkedList<T, N>::operator+(const ArrayLinkedList &rhs) const
 {
     ArrayLinkedList result(*this);
     result += rhs;
@@ -928,47 +1709,100 @@ std::ostream &operator<<(std::ostream &out, const ArrayLinkedList<T, N> &lst)
     lst.display(out);
     return out;
 }
+template <typename T, int NUM_NODES>
+template <typename Pred>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::eraseIf(Pred pred)
+{
+    LIST_OP(LOP_ERASE_IF);
+    int prev = NULL_INDEX, ptr = head;
+    int freedHead = NULL_INDEX, freedTail = NULL_INDEX;
+    try
+    {
+        while (ptr != NULL_INDEX)
+        {
+            int next = LIST_NEXT(pool, ptr);
+            if (pred(pool.node(ptr).data))
+            {
+                if (prev == NULL_INDEX)
+                    head = next;
+                else
+                    pool.node(prev).next = next;
+
+                // Collect the removed nodes into one chain for the pool
+                pool.node(ptr).next = NULL_INDEX;
+                if (freedTail == NULL_INDEX)
+                    freedHead = ptr;
+                else
+                    pool.node(freedTail).next = ptr;
+                freedTail = ptr;
+            }
+            else
+                prev = ptr;
+            ptr = next;
+        }
+    }
+    catch (...)
+    {
+        // The list is intact up to here; do not leak what was unlinked
+        pool.deleteChain(freedHead);
+        throw;
+    }
+    return pool.deleteChain(freedHead);
+}
+
+template <typename T, int NUM_NODES>
+template <typename Pred>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::retainIf(Pred pred)
+{
+    LIST_OP(LOP_RETAIN_IF);
+    return eraseIf([&pred](const T &value) { return !pred(value); });
+}
+
 template <typename T, int N>
-void ArrayLinkedList<T, N>::removeDuplicates()
+POOL_CONSTEXPR void ArrayLinkedList<T, N>::removeDuplicates()
 {
+    LIST_OP(LOP_REMOVE_DUPLICATES);
     if (!isEmpty())
     {
         int ptr = head;
         while (ptr != NULL_INDEX)
         {
             int prev = ptr;
-            int innerPtr = pool[ptr].next;
+            int innerPtr = LIST_NEXT(pool, ptr);
             while (innerPtr != NULL_INDEX)
             {
-                if (pool[innerPtr].data == pool[ptr].data)
+                if (pool.node(innerPtr).data == pool.node(ptr).data)
                 {
                     int duplicateIdx = innerPtr;
-                    pool[prev].next = pool[innerPtr].next;
-                    innerPtr = pool[innerPtr].next;
+                    pool.node(prev).next = pool.node(innerPtr).next;
+                    innerPtr = LIST_NEXT(pool, innerPtr);
                     pool.deleteNode(duplicateIdx);
                 }
                 else
                 {
                     prev = innerPtr;
-                    innerPtr = pool[innerPtr].next;
+                    innerPtr = LIST_NEXT(pool, innerPtr);
                 }
             }
-            ptr = pool[ptr].next;
+            ptr = LIST_NEXT(pool, ptr);
         }
     }
 }
 
 template <typename T, int N>
 
-ArrayLinkedList<T, N>::~ArrayLinkedList()
+POOL_CONSTEXPR ArrayLinkedList<T, N>::~ArrayLinkedList()
 {
     clear();
+    if (ownsTag)
+        pool.releaseOwner(ownerTag);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertSorted(const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertSorted(const T &value)
 {
-    int newIdx = pool.newNode();
+    LIST_OP(LOP_INSERT_SORTED);
+    int newIdx = pool.newNode(ownerTag);
 if (newIdx == NULL_INDEX)
 {
     bool ok = false;
@@ -995,7 +1829,7 @@ if (newIdx == NULL_INDEX)
         {
             std::cout << "Value to delete: ";
             T v;
-            std::getline(std::cin, v);
+            readValue(std::cin, v);
             ok = removeValue(v);
         }
         else
@@ -1010,43 +1844,44 @@ if (newIdx == NULL_INDEX)
         }
     }
 
-    newIdx = pool.newNode();
+    newIdx = pool.newNode(ownerTag);
     if (newIdx == NULL_INDEX)
     {
         std::cout << "Still no free node, aborting insertSorted.\n";
-        return false;
+        return NodeHandle();
     }
 }
 
-    pool[newIdx].data = value;
-    pool[newIdx].next = NULL_INDEX;
+    pool.node(newIdx).data = value;
+    pool.node(newIdx).next = NULL_INDEX;
 
     if (head == NULL_INDEX ||
-        value < pool[head].data)
+        value < pool.node(head).data)
     {
 
-        pool[newIdx].next = head;
+        pool.node(newIdx).next = head;
         head = newIdx;
-        return true;
+        return pool.handleOf(newIdx);
     }
 
     int prev = head;
-    while (pool[prev].next != NULL_INDEX &&
-           pool[pool[prev].next].data < value)
+    while (pool.node(prev).next != NULL_INDEX &&
+           pool.node(pool.node(prev).next).data < value)
     {
-        prev = pool[prev].next;
+        prev = LIST_NEXT(pool, prev);
     }
 
-    pool[newIdx].next = pool[prev].next;
-    pool[prev].next = newIdx;
-    return true;
+    pool.node(newIdx).next = pool.node(prev).next;
+    pool.node(prev).next = newIdx;
+    return pool.handleOf(newIdx);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertSortedDescending(const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertSortedDescending(const T &value)
 {
+    LIST_OP(LOP_INSERT_SORTED_DESC);
 
-    int newIdx = pool.newNode();
+    int newIdx = pool.newNode(ownerTag);
     if (newIdx == NULL_INDEX)
     {
         bool ok = false;
@@ -1069,7 +1904,7 @@ bool ArrayLinkedList<T, NUM_NODES>::insertSortedDescending(const T &value)
             {
                 std::cout << "Value to delete: ";
                 T v;
-                std::getline(std::cin, v);
+                readValue(std::cin, v);
                 ok = removeValue(v);
             }
             else
@@ -1084,39 +1919,40 @@ bool ArrayLinkedList<T, NUM_NODES>::insertSortedDescending(const T &value)
             }
         }
     
-        newIdx = pool.newNode();
+        newIdx = pool.newNode(ownerTag);
         if (newIdx == NULL_INDEX)
         {
             std::cout << "Still no free node, aborting insertSortedDescending.\n";
-            return false;
+            return NodeHandle();
         }
     }
     
-    pool[newIdx].data = value;
-    pool[newIdx].next = NULL_INDEX;
+    pool.node(newIdx).data = value;
+    pool.node(newIdx).next = NULL_INDEX;
 
-    if (head == NULL_INDEX || value > pool[head].data)
+    if (head == NULL_INDEX || value > pool.node(head).data)
     {
-        pool[newIdx].next = head;
+        pool.node(newIdx).next = head;
         head = newIdx;
-        return true;
+        return pool.handleOf(newIdx);
     }
 
     int prev = head;
-    while (pool[prev].next != NULL_INDEX &&
-           pool[pool[prev].next].data > value)
+    while (pool.node(prev).next != NULL_INDEX &&
+           pool.node(pool.node(prev).next).data > value)
     {
-        prev = pool[prev].next;
+        prev = LIST_NEXT(pool, prev);
     }
 
-    pool[newIdx].next = pool[prev].next;
-    pool[prev].next = newIdx;
-    return true;
+    pool.node(newIdx).next = pool.node(prev).next;
+    pool.node(prev).next = newIdx;
+    return pool.handleOf(newIdx);
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::deleteFront()
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::deleteFront()
 {
+    LIST_OP(LOP_DELETE_FRONT);
     if (head == NULL_INDEX)
     {
 
@@ -1124,14 +1960,15 @@ bool ArrayLinkedList<T, NUM_NODES>::deleteFront()
     }
 
     int temp = head;
-    head = pool[head].next;
+    head = pool.node(head).next;
     pool.deleteNode(temp);
     return true;
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::deleteBack()
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::deleteBack()
 {
+    LIST_OP(LOP_DELETE_BACK);
     if (head == NULL_INDEX)
     {
 
@@ -1139,10 +1976,10 @@ bool ArrayLinkedList<T, NUM_NODES>::deleteBack()
     }
 
     int ptr = head, prev = NULL_INDEX;
-    while (pool[ptr].next != NULL_INDEX)
+    while (pool.node(ptr).next != NULL_INDEX)
     {
         prev = ptr;
-        ptr = pool[ptr].next;
+        ptr = LIST_NEXT(pool, ptr);
     }
 
     if (prev == NULL_INDEX)
@@ -1152,7 +1989,7 @@ bool ArrayLinkedList<T, NUM_NODES>::deleteBack()
     }
     else
     {
-        pool[prev].next = NULL_INDEX;
+        pool.node(prev).next = NULL_INDEX;
     }
 
     pool.deleteNode(ptr);
@@ -1160,47 +1997,50 @@ bool ArrayLinkedList<T, NUM_NODES>::deleteBack()
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::sortAscending()
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::sortAscending()
 {
-    for (int i = head; i != NULL_INDEX; i = pool[i].next)
+    LIST_OP(LOP_SORT_ASC);
+    for (int i = head; i != NULL_INDEX; i = LIST_NEXT(pool, i))
     {
-        for (int j = pool[i].next; j != NULL_INDEX; j = pool[j].next)
+        for (int j = LIST_NEXT(pool, i); j != NULL_INDEX; j = LIST_NEXT(pool, j))
         {
-            if (pool[j].data < pool[i].data)
+            if (pool.node(j).data < pool.node(i).data)
             {
-                T tmp = pool[i].data;
-                pool[i].data = pool[j].data;
-                pool[j].data = tmp;
+                T tmp = pool.node(i).data;
+                pool.node(i).data = pool.node(j).data;
+                pool.node(j).data = tmp;
             }
         }
     }
 }
 
 template <typename T, int NUM_NODES>
-void ArrayLinkedList<T, NUM_NODES>::sortDescending()
+POOL_CONSTEXPR void ArrayLinkedList<T, NUM_NODES>::sortDescending()
 {
-    for (int i = head; i != NULL_INDEX; i = pool[i].next)
+    LIST_OP(LOP_SORT_DESC);
+    for (int i = head; i != NULL_INDEX; i = LIST_NEXT(pool, i))
     {
-        for (int j = pool[i].next; j != NULL_INDEX; j = pool[j].next)
+        for (int j = LIST_NEXT(pool, i); j != NULL_INDEX; j = LIST_NEXT(pool, j))
         {
-            if (pool[j].data > pool[i].data)
+            if (pool.node(j).data > pool.node(i).data)
             {
-                T tmp = pool[i].data;
-                pool[i].data = pool[j].data;
-                pool[j].data = tmp;
+                T tmp = pool.node(i).data;
+                pool.node(i).data = pool.node(j).data;
+                pool.node(j).data = tmp;
             }
         }
     }
 }
 
 template <typename T, int NUM_NODES>
-bool ArrayLinkedList<T, NUM_NODES>::insertAtPosition(int position, const T &value)
+POOL_CONSTEXPR NodeHandle ArrayLinkedList<T, NUM_NODES>::insertAtPosition(int position, const T &value)
 {
+    LIST_OP(LOP_INSERT_AT_POSITION);
     int sz = size();
 if (position < 0 || position > sz)
-    return false;
+    return NodeHandle();
 
-int newIdx = pool.newNode();
+int newIdx = pool.newNode(ownerTag);
 if (newIdx == NULL_INDEX)
 {
     bool ok = false;
@@ -1226,7 +2066,7 @@ if (newIdx == NULL_INDEX)
         {
             std::cout << "Value to delete: ";
             T delVal;
-            std::getline(std::cin, delVal);
+            readValue(std::cin, delVal);
             ok = removeValue(delVal);
         }
         else
@@ -1241,20 +2081,20 @@ if (newIdx == NULL_INDEX)
         }
     }
 
-    newIdx = pool.newNode();
+    newIdx = pool.newNode(ownerTag);
     if (newIdx == NULL_INDEX)
     {
         std::cout << "Still no free node, aborting insertAtPosition.\n";
-        return false;
+        return NodeHandle();
     }
 }
 
 
-    pool[newIdx].data = value;
+    pool.node(newIdx).data = value;
 
     if (position == 0)
     {
-        pool[newIdx].next = head;
+        pool.node(newIdx).next = head;
         head = newIdx;
     }
     else
@@ -1262,14 +2102,186 @@ if (newIdx == NULL_INDEX)
         int prev = head;
         for (int i = 1; i < position; ++i)
         {
-            prev = pool[prev].next;
+            prev = LIST_NEXT(pool, prev);
         }
-        pool[newIdx].next = pool[prev].next;
-        pool[prev].next = newIdx;
+        pool.node(newIdx).next = pool.node(prev).next;
+        pool.node(prev).next = newIdx;
+    }
+
+    return pool.handleOf(newIdx);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int ArrayLinkedList<T, NUM_NODES>::adoptNode(ArrayLinkedList &other, int idx)
+{
+    if (&pool == &other.pool)
+    {
+        pool.setOwner(idx, ownerTag);
+        return idx;
     }
 
+    int nodeIdx = pool.newNode(ownerTag);
+    pool.node(nodeIdx).data = other.pool.node(idx).data;
+    other.pool.deleteNode(idx);
+    return nodeIdx;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::combineSorted(ArrayLinkedList &other, CombineMode mode)
+{
+    LIST_OP(ListOpId(LOP_MERGE + static_cast<int>(mode)));
+    bool sharedPool = (&pool == &other.pool);
+    bool takesFromOther = (mode == COMBINE_MERGE || mode == COMBINE_UNION);
+
+    // Copying between pools must not run out of nodes halfway through
+    if (!sharedPool && takesFromOther && pool.freeCount() < other.size())
+        return false;
+
+    int a = head, b = other.head;
+    int newHead = NULL_INDEX, tail = NULL_INDEX;
+    other.head = NULL_INDEX;
+
+    while (a != NULL_INDEX && b != NULL_INDEX)
+    {
+        int keep = NULL_INDEX;
+        bool aLess = pool.node(a).data < other.pool.node(b).data;
+        bool bLess = other.pool.node(b).data < pool.node(a).data;
+
+        // A merge is stable: on ties the node from this list goes first
+        if (aLess || (mode == COMBINE_MERGE && !bLess))
+        {
+            int next = LIST_NEXT(pool, a);
+            if (mode == COMBINE_INTERSECTION)
+                pool.deleteNode(a);
+            else
+                keep = a;
+            a = next;
+        }
+        else if (bLess)
+        {
+            int next = LIST_NEXT(other.pool, b);
+            if (takesFromOther)
+                keep = adoptNode(other, b);
+            else
+                other.pool.deleteNode(b);
+            b = next;
+        }
+        else
+        {
+            // Equal values: keep one from this list, drop the one from other
+            int nextA = LIST_NEXT(pool, a);
+            int nextB = LIST_NEXT(other.pool, b);
+            if (mode == COMBINE_DIFFERENCE)
+                pool.deleteNode(a);
+            else
+                keep = a;
+            other.pool.deleteNode(b);
+            a = nextA;
+            b = nextB;
+        }
+
+        if (keep != NULL_INDEX)
+        {
+            if (tail == NULL_INDEX)
+                newHead = keep;
+            else
+                pool.node(tail).next = keep;
+            tail = keep;
+        }
+    }
+
+    // Whatever remains of this list is either kept as one chain or dropped
+    int rest = NULL_INDEX;
+    if (a != NULL_INDEX)
+    {
+        if (mode == COMBINE_INTERSECTION)
+        {
+            while (a != NULL_INDEX)
+            {
+                int next = LIST_NEXT(pool, a);
+                pool.deleteNode(a);
+                a = next;
+            }
+        }
+        else
+            rest = a;
+    }
+    else if (b != NULL_INDEX)
+    {
+        if (takesFromOther && sharedPool)
+        {
+            rest = b;
+            for (; b != NULL_INDEX; b = LIST_NEXT(pool, b))
+                pool.setOwner(b, ownerTag);
+        }
+        else if (takesFromOther)
+        {
+            // Copy the tail of other node by node into this pool
+            while (b != NULL_INDEX)
+            {
+                int next = LIST_NEXT(other.pool, b);
+                int keep = adoptNode(other, b);
+                if (tail == NULL_INDEX)
+                    newHead = keep;
+                else
+                    pool.node(tail).next = keep;
+                tail = keep;
+                b = next;
+            }
+        }
+        else
+        {
+            while (b != NULL_INDEX)
+            {
+                int next = LIST_NEXT(other.pool, b);
+                other.pool.deleteNode(b);
+                b = next;
+            }
+        }
+    }
+
+    if (tail == NULL_INDEX)
+        newHead = rest;
+    else
+        pool.node(tail).next = rest;
+    head = newHead;
     return true;
 }
 
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::merge(ArrayLinkedList &other)
+{
+    if (this == &other)
+        return true;
+    return combineSorted(other, COMBINE_MERGE);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::setUnion(ArrayLinkedList &other)
+{
+    if (this == &other)
+        return true;
+    return combineSorted(other, COMBINE_UNION);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::setIntersection(ArrayLinkedList &other)
+{
+    if (this == &other)
+        return true;
+    return combineSorted(other, COMBINE_INTERSECTION);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool ArrayLinkedList<T, NUM_NODES>::setDifference(ArrayLinkedList &other)
+{
+    if (this == &other)
+    {
+        clear();
+        return true;
+    }
+    return combineSorted(other, COMBINE_DIFFERENCE);
+}
+
 #endif // LIST_H
 
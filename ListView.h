@@ -0,0 +1,558 @@
+/*-- ListView.h ------------------------------------------------------------
+
+  This header file defines lazy, non-owning views over an ArrayLinkedList.
+
+  A view walks the pool chain only when it is iterated and never
+  allocates nodes; adaptors wrap another view (or any range with begin()
+  and end()) and are composed with operator|:
+
+     for (int v : listView(list) | filter(isEven) | transform(square) | take(3))
+         ...
+
+  Each element is read from its node, passed through the adaptors and
+  handed to the loop body before the next node is visited. A view refers
+  to the list's pool, so the list must outlive it and must not change
+  while it is iterated.
+
+  Basic operations are:
+     listView(list)          – view of the elements of list, front to back
+     filter(pred)            – elements for which pred(element) is true
+     transform(f)            – f(element) instead of each element
+     take(n)                 – at most the first n elements
+     drop(n)                 – all but the first n elements
+     appendTo(list, view)    – materialize: append the view to a list
+     toVector(view)          – materialize into a std::vector
+
+  With coroutine support (C++20) there is also:
+     ListGenerator<T>        – move-only generator type; co_yield values
+                               of type T and iterate it like a view
+     generate(view)          – generator yielding the elements of view
+
+  Adaptors accept a ListGenerator as their source, so a coroutine can
+  feed a view pipeline and a view can feed a coroutine.
+-------------------------------------------------------------------------*/
+
+#ifndef LIST_VIEW_H
+#define LIST_VIEW_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#define LIST_VIEW_COROUTINES
+#endif
+#endif
+
+/***** ListRange *****/
+template <typename T, int NUM_NODES>
+class ListRange
+{
+public:
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        iterator() : pool(nullptr), idx(NULL_INDEX) {}
+        iterator(const NodePool<T, NUM_NODES> *p, int i) : pool(p), idx(i) {}
+
+        reference operator*() const { return pool->node(idx).data; }
+        pointer operator->() const { return &pool->node(idx).data; }
+        iterator &operator++()
+        {
+            idx = pool->node(idx).next;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const iterator &other) const { return idx == other.idx; }
+        bool operator!=(const iterator &other) const { return idx != other.idx; }
+
+    private:
+        const NodePool<T, NUM_NODES> *pool;
+        int idx;
+    };
+
+    ListRange(const NodePool<T, NUM_NODES> &p, int first) : pool(&p), head(first) {}
+
+    iterator begin() const { return iterator(pool, head); }
+    iterator end() const { return iterator(pool, NULL_INDEX); }
+
+private:
+    const NodePool<T, NUM_NODES> *pool;
+    int head;
+};
+
+template <typename T, int NUM_NODES>
+ListRange<T, NUM_NODES> listView(const ArrayLinkedList<T, NUM_NODES> &list)
+{
+    return ListRange<T, NUM_NODES>(list.getPool(), list.getHead());
+}
+/*----------------------------------------------------------------------
+  Precondition:  list outlives the view and is not modified while the
+                 view is iterated.
+  Postcondition: Returns a view of list's elements; nothing is copied.
+-----------------------------------------------------------------------*/
+
+/***** FilterView *****/
+template <typename Base, typename Pred>
+class FilterView
+{
+    typedef decltype(std::declval<Base &>().begin()) BaseIter;
+
+public:
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename std::iterator_traits<BaseIter>::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type *pointer;
+        typedef decltype(*std::declval<BaseIter &>()) reference;
+
+        iterator() : view(nullptr) {}
+        iterator(FilterView *v, BaseIter i) : view(v), it(i) { skip(); }
+
+        reference operator*() const { return *it; }
+        iterator &operator++()
+        {
+            ++it;
+            skip();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator &other) const { return it == other.it; }
+        bool operator!=(const iterator &other) const { return !(it == other.it); }
+
+    private:
+        void skip()
+        {
+            while (it != view->last && !view->pred(*it))
+                ++it;
+        }
+
+        FilterView *view;
+        BaseIter it;
+    };
+
+    FilterView(Base b, Pred p) : base(std::move(b)), pred(std::move(p)) {}
+
+    iterator begin()
+    {
+        last = base.end();
+        return iterator(this, base.begin());
+    }
+    iterator end()
+    {
+        last = base.end();
+        return iterator(this, last);
+    }
+
+private:
+    Base base;
+    Pred pred;
+    BaseIter last;
+};
+
+template <typename Pred>
+struct FilterAdaptor
+{
+    Pred pred;
+};
+
+template <typename Pred>
+FilterAdaptor<Pred> filter(Pred pred)
+{
+    return FilterAdaptor<Pred>{std::move(pred)};
+}
+
+template <typename Base, typename Pred>
+FilterView<Base, Pred> operator|(Base base, FilterAdaptor<Pred> a)
+{
+    return FilterView<Base, Pred>(std::move(base), std::move(a.pred));
+}
+/*----------------------------------------------------------------------
+  Precondition:  pred is callable as bool pred(element).
+  Postcondition: The view yields, in order, the elements of base for
+                 which pred is true; pred runs as the view is iterated.
+-----------------------------------------------------------------------*/
+
+/***** TransformView *****/
+template <typename Base, typename Func>
+class TransformView
+{
+    typedef decltype(std::declval<Base &>().begin()) BaseIter;
+
+public:
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef decltype(std::declval<Func &>()(*std::declval<BaseIter &>())) reference;
+        typedef typename std::decay<reference>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type *pointer;
+
+        iterator() : func(nullptr) {}
+        iterator(Func *f, BaseIter i) : func(f), it(i) {}
+
+        reference operator*() const { return (*func)(*it); }
+        iterator &operator++()
+        {
+            ++it;
+            return *this;
+        }
+        void operator++(int) { ++it; }
+        bool operator==(const iterator &other) const { return it == other.it; }
+        bool operator!=(const iterator &other) const { return !(it == other.it); }
+
+    private:
+        Func *func;
+        BaseIter it;
+    };
+
+    TransformView(Base b, Func f) : base(std::move(b)), func(std::move(f)) {}
+
+    iterator begin() { return iterator(&func, base.begin()); }
+    iterator end() { return iterator(&func, base.end()); }
+
+private:
+    Base base;
+    Func func;
+};
+
+template <typename Func>
+struct TransformAdaptor
+{
+    Func func;
+};
+
+template <typename Func>
+TransformAdaptor<Func> transform(Func func)
+{
+    return TransformAdaptor<Func>{std::move(func)};
+}
+
+template <typename Base, typename Func>
+TransformView<Base, Func> operator|(Base base, TransformAdaptor<Func> a)
+{
+    return TransformView<Base, Func>(std::move(base), std::move(a.func));
+}
+/*----------------------------------------------------------------------
+  Precondition:  f is callable on an element of base.
+  Postcondition: The view yields f(element) for every element of base;
+                 f runs each time an element is dereferenced.
+-----------------------------------------------------------------------*/
+
+/***** TakeView *****/
+template <typename Base>
+class TakeView
+{
+    typedef decltype(std::declval<Base &>().begin()) BaseIter;
+
+public:
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename std::iterator_traits<BaseIter>::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type *pointer;
+        typedef decltype(*std::declval<BaseIter &>()) reference;
+
+        iterator() : left(0) {}
+        iterator(BaseIter i, std::size_t n) : it(i), left(n) {}
+
+        reference operator*() const { return *it; }
+        iterator &operator++()
+        {
+            --left;
+            // Stop here rather than advance the base past the last element
+            // taken, which would run a filter or generator needlessly
+            if (left != 0)
+                ++it;
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator &other) const
+        {
+            return (left == 0 && other.left == 0) || it == other.it;
+        }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        BaseIter it;
+        std::size_t left;
+    };
+
+    TakeView(Base b, std::size_t n) : base(std::move(b)), count(n) {}
+
+    iterator begin() { return iterator(base.begin(), count); }
+    iterator end() { return iterator(base.end(), 0); }
+
+private:
+    Base base;
+    std::size_t count;
+};
+
+struct TakeAdaptor
+{
+    std::size_t count;
+};
+
+inline TakeAdaptor take(std::size_t n)
+{
+    return TakeAdaptor{n};
+}
+
+template <typename Base>
+TakeView<Base> operator|(Base base, TakeAdaptor a)
+{
+    return TakeView<Base>(std::move(base), a.count);
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: The view yields the first n elements of base (all of
+                 them if there are fewer); nodes after the n-th are not
+                 visited.
+-----------------------------------------------------------------------*/
+
+/***** DropView *****/
+template <typename Base>
+class DropView
+{
+    typedef decltype(std::declval<Base &>().begin()) BaseIter;
+
+public:
+    typedef BaseIter iterator;
+
+    DropView(Base b, std::size_t n) : base(std::move(b)), count(n) {}
+
+    iterator begin()
+    {
+        iterator it = base.begin();
+        iterator last = base.end();
+        for (std::size_t i = 0; i < count && it != last; ++i)
+            ++it;
+        return it;
+    }
+    iterator end() { return base.end(); }
+
+private:
+    Base base;
+    std::size_t count;
+};
+
+struct DropAdaptor
+{
+    std::size_t count;
+};
+
+inline DropAdaptor drop(std::size_t n)
+{
+    return DropAdaptor{n};
+}
+
+template <typename Base>
+DropView<Base> operator|(Base base, DropAdaptor a)
+{
+    return DropView<Base>(std::move(base), a.count);
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: The view yields the elements of base after the first n
+                 (none if there are n or fewer). The first n are skipped
+                 when begin() is called.
+-----------------------------------------------------------------------*/
+
+/***** appendTo *****/
+template <typename T, int NUM_NODES, typename View>
+int appendTo(ArrayLinkedList<T, NUM_NODES> &list, View &&view)
+{
+    typename ArrayLinkedList<T, NUM_NODES>::Cursor at = list.cursor();
+    while (at.advance())
+        ;
+    int added = 0;
+    for (auto &&value : view)
+    {
+        if (!at.insertBefore(value))
+            break;
+        ++added;
+    }
+    return added;
+}
+/*----------------------------------------------------------------------
+  Precondition:  view does not read list itself (its nodes would be
+                 appended while they are walked).
+  Postcondition: The elements of view are appended to list in order, one
+                 walk to the tail and O(1) per element. Returns the
+                 number appended; it stops early, without prompting, when
+                 the pool is full.
+-----------------------------------------------------------------------*/
+
+/***** toVector *****/
+template <typename View>
+auto toVector(View &&view) -> std::vector<typename std::decay<decltype(*view.begin())>::type>
+{
+    std::vector<typename std::decay<decltype(*view.begin())>::type> result;
+    for (auto &&value : view)
+        result.push_back(value);
+    return result;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the elements of view in order.
+-----------------------------------------------------------------------*/
+
+#ifdef LIST_VIEW_COROUTINES
+
+/***** ListGenerator *****/
+template <typename T>
+class ListGenerator
+{
+public:
+    struct promise_type
+    {
+        const T *current = nullptr;
+        std::exception_ptr error;
+
+        ListGenerator get_return_object()
+        {
+            return ListGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T &value) noexcept
+        {
+            // The yielded object lives until the coroutine is resumed
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        iterator() : coro(nullptr) {}
+        explicit iterator(Handle h) : coro(h) {}
+
+        reference operator*() const { return *coro.promise().current; }
+        pointer operator->() const { return coro.promise().current; }
+        iterator &operator++()
+        {
+            coro.resume();
+            rethrow(coro);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(const iterator &other) const { return finished() == other.finished(); }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        bool finished() const { return !coro || coro.done(); }
+
+        Handle coro;
+    };
+
+    ListGenerator(ListGenerator &&other) noexcept : coro(other.coro), started(other.started)
+    {
+        other.coro = nullptr;
+    }
+    ListGenerator &operator=(ListGenerator &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (coro)
+                coro.destroy();
+            coro = other.coro;
+            started = other.started;
+            other.coro = nullptr;
+        }
+        return *this;
+    }
+    ListGenerator(const ListGenerator &) = delete;
+    ListGenerator &operator=(const ListGenerator &) = delete;
+    ~ListGenerator()
+    {
+        if (coro)
+            coro.destroy();
+    }
+
+    iterator begin()
+    {
+        if (coro && !started)
+        {
+            started = true;
+            coro.resume();
+            rethrow(coro);
+        }
+        return iterator(coro);
+    }
+    iterator end() { return iterator(); }
+
+private:
+    explicit ListGenerator(Handle h) : coro(h), started(false) {}
+
+    static void rethrow(Handle h)
+    {
+        if (h.done() && h.promise().error)
+            std::rethrow_exception(h.promise().error);
+    }
+
+    Handle coro;
+    bool started;
+};
+/*----------------------------------------------------------------------
+  Return type for coroutines that co_yield T.
+
+  Precondition:  begin() is called once; the generator is a single-pass
+                 range.
+  Postcondition: The body runs up to each co_yield as the range is
+                 iterated; an exception escaping the body is rethrown
+                 from begin() or ++.
+-----------------------------------------------------------------------*/
+
+/***** generate *****/
+template <typename View>
+ListGenerator<typename std::decay<decltype(*std::declval<View &>().begin())>::type> generate(View view)
+{
+    for (auto &&value : view)
+        co_yield value;
+}
+/*----------------------------------------------------------------------
+  Precondition:  Whatever view refers to (e.g. the list) outlives the
+                 generator.
+  Postcondition: Returns a generator yielding the elements of view in
+                 order; view is kept in the coroutine frame.
+-----------------------------------------------------------------------*/
+
+#endif // LIST_VIEW_COROUTINES
+
+#endif // LIST_VIEW_H
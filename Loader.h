@@ -0,0 +1,202 @@
+/*-- Loader.h --------------------------------------------------------------
+
+  This header file defines a bulk loader that appends the values of a
+  delimiter-separated text file to an ArrayLinkedList.
+
+  The file is mapped with mmap (one sequential pass, no per-line reads),
+  numeric values are parsed in place with std::from_chars, and the new
+  nodes are linked into one chain that is appended to the list in a
+  single step.
+
+  Basic operations are:
+     loadListBuffer(data, size, list, delim) – append values from memory
+     loadListFile(path, list, delim)         – same, from a file
+
+  Values are separated by delim and/or newlines ("\r\n" is accepted);
+  empty fields are skipped. Numeric fields may have surrounding blanks;
+  std::string fields are taken verbatim; other T are read with >>.
+-------------------------------------------------------------------------*/
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/***** LoadResult *****/
+struct LoadResult
+{
+    size_t loaded;    // values appended to the list
+    size_t rejected;  // fields that did not parse as T
+    bool poolFull;    // stopped early: the pool ran out of nodes
+};
+
+/***** TextParser *****/
+template <typename T, bool NUMERIC = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>
+struct TextParser
+{
+    // Fallback for class types: a reused stream, one >> per field
+    static bool parse(const char *first, const char *last, T &value)
+    {
+        static std::istringstream is;
+        is.clear();
+        is.str(std::string(first, last));
+        is >> value;
+        return !is.fail() && (is >> std::ws).eof();
+    }
+};
+
+template <typename T>
+struct TextParser<T, true>
+{
+    static bool parse(const char *first, const char *last, T &value)
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+            ++first;
+        while (last != first && (last[-1] == ' ' || last[-1] == '\t'))
+            --last;
+        if (first != last && *first == '+')
+            ++first;
+        std::from_chars_result r = std::from_chars(first, last, value);
+        return r.ec == std::errc() && r.ptr == last;
+    }
+};
+
+template <>
+struct TextParser<std::string, false>
+{
+    static bool parse(const char *first, const char *last, std::string &value)
+    {
+        value.assign(first, last);
+        return true;
+    }
+};
+/*----------------------------------------------------------------------
+  parse(first, last, value) converts one field (without its delimiter).
+
+  Precondition:  [first, last) is a valid range.
+  Postcondition: Returns true and sets value if the whole field parsed.
+-----------------------------------------------------------------------*/
+
+/***** loadListBuffer *****/
+template <typename T, int NUM_NODES>
+LoadResult loadListBuffer(const char *data, size_t size, ArrayLinkedList<T, NUM_NODES> &list,
+                          char delimiter = '\n')
+{
+    NodePool<T, NUM_NODES> &pool = list.getPool();
+    unsigned char tag = list.getOwnerTag();
+    LoadResult result = {0, 0, false};
+
+    int chainHead = NULL_INDEX, chainTail = NULL_INDEX;
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end)
+    {
+        const char *stop = p;
+        while (stop < end && *stop != delimiter && *stop != '\n')
+            ++stop;
+        const char *fieldEnd = stop;
+        if (fieldEnd > p && fieldEnd[-1] == '\r')
+            --fieldEnd;
+        const char *next = stop + 1;
+
+        if (fieldEnd == p)
+        {
+            p = next;
+            continue;
+        }
+
+        int idx = pool.newNode(tag);
+        if (idx == NULL_INDEX)
+        {
+            result.poolFull = true;
+            break;
+        }
+        if (!TextParser<T>::parse(p, fieldEnd, pool.node(idx).data))
+        {
+            pool.deleteNode(idx);
+            ++result.rejected;
+            p = next;
+            continue;
+        }
+        if (chainTail == NULL_INDEX)
+            chainHead = idx;
+        else
+            pool.node(chainTail).next = idx;
+        chainTail = idx;
+        ++result.loaded;
+        p = next;
+    }
+
+    if (chainHead == NULL_INDEX)
+        return result;
+
+    // The nodes were allocated with the list's tag, so the chain is linked
+    // after the tail as is: no second pass over the new rows
+    list.appendChain(chainHead, chainTail);
+    return result;
+}
+/*----------------------------------------------------------------------
+  Precondition:  data points at size bytes of text.
+  Postcondition: The parsed values are appended to list in input order.
+                 Loading stops without prompting once the pool is full.
+-----------------------------------------------------------------------*/
+
+/***** loadListFile *****/
+template <typename T, int NUM_NODES>
+LoadResult loadListFile(const std::string &path, ArrayLinkedList<T, NUM_NODES> &list,
+                        char delimiter = '\n')
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("load: cannot open " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("load: cannot stat " + path);
+    }
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        LoadResult empty = {0, 0, false};
+        return empty;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *data = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("load: mmap failed for " + path);
+    ::madvise(data, size, MADV_SEQUENTIAL);
+
+    LoadResult result;
+    try
+    {
+        result = loadListBuffer(static_cast<const char *>(data), size, list, delimiter);
+    }
+    catch (...)
+    {
+        ::munmap(data, size);
+        throw;
+    }
+    ::munmap(data, size);
+    return result;
+}
+/*----------------------------------------------------------------------
+  Precondition:  path names a readable regular file.
+  Postcondition: Same as loadListBuffer on the file's contents.
+  Throws: std::runtime_error if the file cannot be opened or mapped.
+-----------------------------------------------------------------------*/
+
+#endif // LOADER_H
@@ -0,0 +1,469 @@
+/*-- MappedPool.h ----------------------------------------------------------
+
+  This header file defines the template class MappedNodePool, a NodePool
+  that lives in a memory-mapped file.
+
+  Because list links are slot indices rather than pointers, the pool can
+  be used in place from the mapping: opening a cleanly closed file costs
+  one mmap (pages are read lazily on first touch) and a link check, and
+  no copying. T must be trivially copyable.
+
+  File layout (each part padded to 64 bytes):
+     MappedPoolHeader   magic, version, layout checks, clean flag
+     NodePool<T, N>     the live pool object (slots, tags, free list)
+     checkpoint 0       MappedCheckpoint (sequence, list heads) + pool copy
+     checkpoint 1       the same; checkpoints alternate between the two
+
+  Basic operations are:
+     Constructor:   Open (or create and format) the file; validate layout.
+     pool:          The mapped NodePool.
+     created:       Whether the file was formatted by this open.
+     recovered:     Whether this open rolled back to the last checkpoint.
+     list:          Persistent list stored in a head slot.
+     checkpoint:    Copy list heads and pool into a checkpoint, msync.
+     close:         Checkpoint, mark the file clean, release and unmap.
+
+  The lists are owned by the MappedNodePool so they can be detached
+  (rather than cleared) before the mapping goes away.
+
+  The live pool is changed in place and list heads live in the List
+  objects, so between checkpoints the file on disk is not consistent on
+  its own. Recovery therefore works from the checkpoints: checkpoint()
+  writes the copy it does not depend on, invalidating its sequence
+  first and storing the new one last, so a crash at any point leaves at
+  least one complete checkpoint. A file closed with close() is marked
+  clean and reopened in place; any other file (crash, kill, lost pages)
+  is rolled back to the newest checkpoint whose links pass checkChains,
+  losing the changes made after it. Every used node must belong to one
+  of the list() chains.
+-------------------------------------------------------------------------*/
+
+#ifndef MAPPED_POOL_H
+#define MAPPED_POOL_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const int MAPPED_MAX_LISTS = 16;
+static const unsigned int MAPPED_POOL_VERSION = 3; // 3: checkpoint copies
+
+/***** MappedPoolHeader *****/
+struct MappedPoolHeader
+{
+    char magic[8];                    // "NPOOLMAP"
+    unsigned int version;             // MAPPED_POOL_VERSION
+    unsigned int byteOrder;           // 0x01020304 as written
+    unsigned int numNodes;            // NUM_NODES
+    unsigned int nodeSize;            // sizeof(Node)
+    unsigned long long poolSize;      // sizeof(NodePool<T, N>)
+    unsigned int clean;               // 1 after close(), 0 while open
+};
+
+/***** MappedCheckpoint *****/
+struct MappedCheckpoint
+{
+    unsigned long long sequence;      // 0 while being written
+    int listHeads[MAPPED_MAX_LISTS];  // heads matching the pool copy
+};
+
+/***** mappedPoolCheckHeader *****/
+inline void mappedPoolCheckHeader(const MappedPoolHeader &header, unsigned int numNodes,
+                                  unsigned int nodeSize, unsigned long long poolSize)
+{
+    if (std::memcmp(header.magic, "NPOOLMAP", sizeof(header.magic)) != 0)
+        throw std::runtime_error("mapped pool: not a NodePool file");
+    if (header.version != MAPPED_POOL_VERSION || header.byteOrder != 0x01020304)
+        throw std::runtime_error("mapped pool: unsupported version or byte order");
+    if (header.numNodes != numNodes || header.nodeSize != nodeSize || header.poolSize != poolSize)
+        throw std::runtime_error("mapped pool: pool layout does not match");
+}
+/*----------------------------------------------------------------------
+  Precondition:  header points at a mapped file header.
+  Postcondition: Returns if the file matches this build's pool layout.
+  Throws: std::runtime_error otherwise.
+-----------------------------------------------------------------------*/
+
+inline void mappedPoolFormatHeader(MappedPoolHeader &header, unsigned int numNodes,
+                                   unsigned int nodeSize, unsigned long long poolSize)
+{
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "NPOOLMAP", sizeof(header.magic));
+    header.version = MAPPED_POOL_VERSION;
+    header.byteOrder = 0x01020304;
+    header.numNodes = numNodes;
+    header.nodeSize = nodeSize;
+    header.poolSize = poolSize;
+}
+
+/***** MappedNodePool class *****/
+template <typename T, int NUM_NODES>
+class MappedNodePool
+{
+public:
+    typedef NodePool<T, NUM_NODES> Pool;
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+
+    /***** Class constructor *****/
+    explicit MappedNodePool(const std::string &path);
+    /*----------------------------------------------------------------------
+      Map the pool file at path, creating and formatting it if missing or
+      empty.
+
+      Precondition:  None
+      Postcondition: pool() is usable; registered owner tags from earlier
+                     runs are dropped so lists can attach again. A file
+                     not closed cleanly, or whose live links do not match
+                     its heads, is rolled back to its newest valid
+                     checkpoint (recovered() is then true).
+      Throws: std::runtime_error on I/O errors, a layout mismatch, or
+              when no checkpoint passes checkChains.
+    -----------------------------------------------------------------------*/
+
+    /***** Class destructor *****/
+    ~MappedNodePool();
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Same as close().
+    -----------------------------------------------------------------------*/
+
+    Pool &pool();
+    bool created() const;
+    bool recovered() const;
+
+    List &list(int slot);
+    /*----------------------------------------------------------------------
+      Get the persistent list of head slot (0 <= slot < MAPPED_MAX_LISTS).
+
+      Precondition:  The file is open.
+      Postcondition: On first use the list is created over pool() and
+                     attached to the chain saved for that slot; its head is
+                     saved again by every checkpoint.
+      Throws: std::out_of_range for a bad slot.
+    -----------------------------------------------------------------------*/
+
+    void checkpoint();
+    /*----------------------------------------------------------------------
+      Make the current state durable.
+
+      Precondition:  The file is open; no list operation is running.
+      Postcondition: The older checkpoint holds the list heads and a copy
+                     of the pool, flushed with msync(MS_SYNC), and is now
+                     the newest. O(sizeof(Pool)).
+      Throws: std::runtime_error if msync fails; the other checkpoint
+              is still intact.
+    -----------------------------------------------------------------------*/
+
+    void close();
+    /*----------------------------------------------------------------------
+      Precondition:  References returned by list() are not used afterwards.
+      Postcondition: Checkpointed and marked clean; lists detached and
+                     destroyed without freeing their nodes; file unmapped
+                     and closed.
+      Throws: std::runtime_error if the checkpoint fails; the file is
+              unmapped and closed all the same.
+    -----------------------------------------------------------------------*/
+
+private:
+    MappedNodePool(const MappedNodePool &);
+    MappedNodePool &operator=(const MappedNodePool &);
+
+    static size_t padded(size_t bytes);
+    static size_t poolOffset();
+    static size_t checkpointOffset(int which);
+    MappedCheckpoint &savedHeads(int which);
+    Pool *savedPool(int which);
+    int newestCheckpoint();
+    void writeCheckpoint(int which, unsigned long long sequence);
+    void restore();
+    void sync(size_t offset, size_t bytes);
+    void release();
+
+    /******** Data Members ********/
+    int fd;
+    void *base;
+    size_t mappedBytes;
+    bool fresh;
+    bool rolledBack;
+    int current; // newest valid checkpoint
+    MappedPoolHeader *header;
+    Pool *mappedPool;
+    List *lists[MAPPED_MAX_LISTS];
+
+}; //--- end of MappedNodePool class
+
+/***** Implementation Section *****/
+
+template <typename T, int NUM_NODES>
+size_t MappedNodePool<T, NUM_NODES>::padded(size_t bytes)
+{
+    return (bytes + 63) / 64 * 64;
+}
+
+template <typename T, int NUM_NODES>
+size_t MappedNodePool<T, NUM_NODES>::poolOffset()
+{
+    return padded(sizeof(MappedPoolHeader));
+}
+
+template <typename T, int NUM_NODES>
+size_t MappedNodePool<T, NUM_NODES>::checkpointOffset(int which)
+{
+    return poolOffset() + padded(sizeof(Pool)) +
+           (size_t)which * (padded(sizeof(MappedCheckpoint)) + padded(sizeof(Pool)));
+}
+
+template <typename T, int NUM_NODES>
+MappedCheckpoint &MappedNodePool<T, NUM_NODES>::savedHeads(int which)
+{
+    return *reinterpret_cast<MappedCheckpoint *>(static_cast<char *>(base) + checkpointOffset(which));
+}
+
+template <typename T, int NUM_NODES>
+typename MappedNodePool<T, NUM_NODES>::Pool *MappedNodePool<T, NUM_NODES>::savedPool(int which)
+{
+    void *bytes = static_cast<char *>(base) + checkpointOffset(which) + padded(sizeof(MappedCheckpoint));
+    return std::launder(static_cast<Pool *>(bytes));
+}
+
+template <typename T, int NUM_NODES>
+int MappedNodePool<T, NUM_NODES>::newestCheckpoint()
+{
+    // A checkpoint only counts if it was finished and its links add up
+    int best = -1;
+    for (int i = 0; i < 2; ++i)
+    {
+        MappedCheckpoint &saved = savedHeads(i);
+        if (saved.sequence == 0)
+            continue;
+        if (best >= 0 && saved.sequence <= savedHeads(best).sequence)
+            continue;
+        if (savedPool(i)->checkChains(saved.listHeads, MAPPED_MAX_LISTS) == 0)
+            best = i;
+    }
+    return best;
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::writeCheckpoint(int which, unsigned long long sequence)
+{
+    MappedCheckpoint &saved = savedHeads(which);
+    saved.sequence = 0;
+    sync(checkpointOffset(which), sizeof(MappedCheckpoint));
+
+    for (int i = 0; i < MAPPED_MAX_LISTS; ++i)
+    {
+        if (lists[i] != 0)
+            saved.listHeads[i] = lists[i]->getHead();
+        else if (current >= 0)
+            saved.listHeads[i] = savedHeads(current).listHeads[i];
+        else
+            saved.listHeads[i] = NULL_INDEX;
+    }
+    std::memcpy(static_cast<void *>(savedPool(which)), static_cast<const void *>(mappedPool), sizeof(Pool));
+    sync(checkpointOffset(which), padded(sizeof(MappedCheckpoint)) + sizeof(Pool));
+
+    saved.sequence = sequence;
+    sync(checkpointOffset(which), sizeof(MappedCheckpoint));
+    current = which;
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::restore()
+{
+    current = newestCheckpoint();
+    if (current < 0)
+        throw std::runtime_error("mapped pool: no valid checkpoint to recover from");
+    std::memcpy(static_cast<void *>(mappedPool), static_cast<const void *>(savedPool(current)), sizeof(Pool));
+    rolledBack = true;
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::sync(size_t offset, size_t bytes)
+{
+    // msync wants a page-aligned start
+    size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+    size_t start = offset / page * page;
+    if (::msync(static_cast<char *>(base) + start, offset + bytes - start, MS_SYNC) != 0)
+        throw std::runtime_error("mapped pool: msync failed");
+}
+
+template <typename T, int NUM_NODES>
+MappedNodePool<T, NUM_NODES>::MappedNodePool(const std::string &path)
+    : fd(-1), base(0), mappedBytes(checkpointOffset(2)), fresh(false), rolledBack(false),
+      current(-1), header(0), mappedPool(0)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedNodePool needs a trivially copyable payload");
+    static_assert(alignof(Pool) <= 64, "pool alignment exceeds header padding");
+
+    for (int i = 0; i < MAPPED_MAX_LISTS; ++i)
+        lists[i] = 0;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        throw std::runtime_error("mapped pool: cannot open " + path + ": " + std::strerror(errno));
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("mapped pool: cannot stat " + path);
+    }
+    fresh = (st.st_size == 0);
+    if (fresh && ::ftruncate(fd, (off_t)mappedBytes) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("mapped pool: cannot size " + path);
+    }
+    if (!fresh && (size_t)st.st_size != mappedBytes)
+    {
+        ::close(fd);
+        throw std::runtime_error("mapped pool: file size does not match pool layout");
+    }
+
+    base = ::mmap(0, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        base = 0;
+        ::close(fd);
+        throw std::runtime_error("mapped pool: mmap failed for " + path);
+    }
+
+    header = static_cast<MappedPoolHeader *>(base);
+    void *poolBytes = static_cast<char *>(base) + poolOffset();
+    try
+    {
+        if (fresh)
+        {
+            mappedPoolFormatHeader(*header, NUM_NODES, sizeof(typename Pool::Node), sizeof(Pool));
+            mappedPool = new (poolBytes) Pool();
+            writeCheckpoint(0, 1); // recovery always has a checkpoint
+        }
+        else
+        {
+            mappedPoolCheckHeader(*header, NUM_NODES, sizeof(typename Pool::Node), sizeof(Pool));
+            mappedPool = std::launder(static_cast<Pool *>(poolBytes));
+            current = newestCheckpoint();
+            // After close() the live pool equals the newest checkpoint;
+            // anything else is rolled back to it
+            if (!header->clean || current < 0 ||
+                mappedPool->checkChains(savedHeads(current).listHeads, MAPPED_MAX_LISTS) != 0)
+                restore();
+        }
+        header->clean = 0;
+        sync(0, sizeof(MappedPoolHeader));
+    }
+    catch (...)
+    {
+        ::munmap(base, mappedBytes);
+        ::close(fd);
+        base = 0;
+        header = 0;
+        mappedPool = 0;
+        throw;
+    }
+    mappedPool->resetOwners();
+}
+
+template <typename T, int NUM_NODES>
+MappedNodePool<T, NUM_NODES>::~MappedNodePool()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+template <typename T, int NUM_NODES>
+typename MappedNodePool<T, NUM_NODES>::Pool &MappedNodePool<T, NUM_NODES>::pool()
+{
+    return *mappedPool;
+}
+
+template <typename T, int NUM_NODES>
+bool MappedNodePool<T, NUM_NODES>::created() const
+{
+    return fresh;
+}
+
+template <typename T, int NUM_NODES>
+bool MappedNodePool<T, NUM_NODES>::recovered() const
+{
+    return rolledBack;
+}
+
+template <typename T, int NUM_NODES>
+typename MappedNodePool<T, NUM_NODES>::List &MappedNodePool<T, NUM_NODES>::list(int slot)
+{
+    if (slot < 0 || slot >= MAPPED_MAX_LISTS)
+        throw std::out_of_range("MappedNodePool::list: slot out of range");
+    if (base == 0)
+        throw std::logic_error("MappedNodePool::list: pool is closed");
+    if (lists[slot] == 0)
+    {
+        lists[slot] = new List(*mappedPool);
+        lists[slot]->attach(savedHeads(current).listHeads[slot]);
+    }
+    return *lists[slot];
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::checkpoint()
+{
+    if (base == 0)
+        return;
+    writeCheckpoint(1 - current, savedHeads(current).sequence + 1);
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::close()
+{
+    if (base == 0)
+        return;
+    try
+    {
+        checkpoint();
+        header->clean = 1;
+        sync(0, sizeof(MappedPoolHeader));
+    }
+    catch (...)
+    {
+        release(); // do not leak the mapping and descriptor
+        throw;
+    }
+    release();
+}
+
+template <typename T, int NUM_NODES>
+void MappedNodePool<T, NUM_NODES>::release()
+{
+    for (int i = 0; i < MAPPED_MAX_LISTS; ++i)
+    {
+        if (lists[i] != 0)
+        {
+            lists[i]->detach();
+            delete lists[i];
+        }
+        lists[i] = 0;
+    }
+    ::munmap(base, mappedBytes);
+    ::close(fd);
+    base = 0;
+    header = 0;
+    mappedPool = 0;
+}
+
+#endif // MAPPED_POOL_H
@@ -0,0 +1,239 @@
+/*-- MemoryReport.h --------------------------------------------------------
+
+  This header file defines memory accounting for NodePool and
+  ArrayLinkedList, for capacity planning.
+
+  A pool's footprint is split into:
+     slotBytes           the Node array (sizeof(Node) * NUM_NODES)
+     indexBytes          owner tags, tag registry and counters
+     liveHeapBytes       heap owned by the payloads of used nodes
+     retainedHeapBytes   heap still owned by payloads of free nodes
+                         (deleteNode does not destroy data, so a freed
+                         std::string keeps its buffer until overwritten)
+     auxHeapBytes        auxiliary storage, e.g. a StringNodePool arena
+
+  Basic operations are:
+     poolMemoryReport(pool)           – PoolMemoryReport of the whole pool
+     ownerMemoryReport(pool)          – one OwnerMemoryReport per owner tag
+     listMemoryReport(list)           – ListMemoryReport of one list
+     writeMemoryReport(os, pool)      – readable breakdown with per-owner
+                                        rows
+
+  PayloadHeap<T>::bytes(value) gives the heap owned by one payload; it
+  knows std::string (beyond the small-string buffer) and std::vector and
+  can be specialised for other types. Heap sizes are capacities, not
+  allocator block sizes.
+-------------------------------------------------------------------------*/
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include "NodePool.h"
+#include "List.h"
+#include "StringArena.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/***** PayloadHeap *****/
+template <typename T>
+struct PayloadHeap
+{
+    static size_t bytes(const T &) { return 0; }
+};
+
+template <typename C, typename Tr, typename A>
+struct PayloadHeap<std::basic_string<C, Tr, A> >
+{
+    static size_t bytes(const std::basic_string<C, Tr, A> &s)
+    {
+        // Characters stored inside the object itself are the SSO buffer
+        const char *chars = reinterpret_cast<const char *>(s.data());
+        const char *self = reinterpret_cast<const char *>(&s);
+        if (chars >= self && chars < self + sizeof(s))
+            return 0;
+        return (s.capacity() + 1) * sizeof(C);
+    }
+};
+
+template <typename U, typename A>
+struct PayloadHeap<std::vector<U, A> >
+{
+    static size_t bytes(const std::vector<U, A> &v)
+    {
+        size_t total = v.capacity() * sizeof(U);
+        for (size_t i = 0; i < v.size(); ++i)
+            total += PayloadHeap<U>::bytes(v[i]);
+        return total;
+    }
+};
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the heap bytes owned by value, not counting
+                 sizeof(value) itself (0 for types without heap storage).
+-----------------------------------------------------------------------*/
+
+/***** report structs *****/
+struct PoolMemoryReport
+{
+    size_t slotBytes;
+    size_t indexBytes;
+    size_t liveHeapBytes;
+    size_t retainedHeapBytes;
+    size_t auxHeapBytes;
+    int usedSlots;
+    int freeSlots;
+    int retainingFreeSlots; // free slots whose payload still owns heap
+
+    size_t totalBytes() const
+    {
+        return slotBytes + indexBytes + liveHeapBytes + retainedHeapBytes + auxHeapBytes;
+    }
+};
+
+struct OwnerMemoryReport
+{
+    unsigned char tag; // SHARED_OWNER for nodes no list has tagged
+    int nodes;
+    size_t slotBytes;
+    size_t heapBytes;
+};
+
+struct ListMemoryReport
+{
+    int nodes;
+    size_t slotBytes;
+    size_t heapBytes;
+
+    size_t totalBytes() const { return slotBytes + heapBytes; }
+};
+
+/***** poolMemoryReport *****/
+template <typename T, int NUM_NODES>
+PoolMemoryReport poolMemoryReport(const NodePool<T, NUM_NODES> &pool)
+{
+    typedef typename NodePool<T, NUM_NODES>::Node Node;
+    const Node *nodes = pool.nodes();
+    const unsigned char *owners = pool.owners();
+
+    PoolMemoryReport r = PoolMemoryReport();
+    r.slotBytes = sizeof(Node) * NUM_NODES;
+    r.indexBytes = sizeof(pool) - r.slotBytes;
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        size_t heap = PayloadHeap<T>::bytes(nodes[i].data);
+        if (owners[i] == FREE_OWNER)
+        {
+            ++r.freeSlots;
+            r.retainedHeapBytes += heap;
+            if (heap)
+                ++r.retainingFreeSlots;
+        }
+        else
+        {
+            ++r.usedSlots;
+            r.liveHeapBytes += heap;
+        }
+    }
+    return r;
+}
+
+template <int NUM_NODES>
+PoolMemoryReport poolMemoryReport(const StringNodePool<NUM_NODES> &pool)
+{
+    PoolMemoryReport r = poolMemoryReport(static_cast<const NodePool<ArenaString, NUM_NODES> &>(pool));
+    r.indexBytes = sizeof(NodePool<ArenaString, NUM_NODES>) - r.slotBytes;
+    r.auxHeapBytes = pool.arenaBytes();
+    return r;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the footprint of pool, one pass over all slots.
+                 For a StringNodePool the arena capacity is auxHeapBytes.
+-----------------------------------------------------------------------*/
+
+/***** ownerMemoryReport *****/
+template <typename T, int NUM_NODES>
+std::vector<OwnerMemoryReport> ownerMemoryReport(const NodePool<T, NUM_NODES> &pool)
+{
+    typedef typename NodePool<T, NUM_NODES>::Node Node;
+    const Node *nodes = pool.nodes();
+    const unsigned char *owners = pool.owners();
+
+    OwnerMemoryReport byTag[256] = {};
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        OwnerMemoryReport &o = byTag[owners[i]];
+        ++o.nodes;
+        o.heapBytes += PayloadHeap<T>::bytes(nodes[i].data);
+    }
+
+    std::vector<OwnerMemoryReport> result;
+    for (int tag = 1; tag < 256; ++tag)
+    {
+        if (byTag[tag].nodes == 0)
+            continue;
+        byTag[tag].tag = (unsigned char)tag;
+        byTag[tag].slotBytes = sizeof(Node) * (size_t)byTag[tag].nodes;
+        result.push_back(byTag[tag]);
+    }
+    return result;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns one entry per owner tag holding used nodes, in
+                 tag order. Lists that share SHARED_OWNER are reported
+                 together; listMemoryReport separates them.
+-----------------------------------------------------------------------*/
+
+/***** listMemoryReport *****/
+template <typename T, int NUM_NODES>
+ListMemoryReport listMemoryReport(const ArrayLinkedList<T, NUM_NODES> &list)
+{
+    const NodePool<T, NUM_NODES> &pool = list.getPool();
+    ListMemoryReport r = ListMemoryReport();
+    for (int ptr = list.getHead(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+    {
+        ++r.nodes;
+        r.heapBytes += PayloadHeap<T>::bytes(pool.node(ptr).data);
+    }
+    r.slotBytes = sizeof(typename NodePool<T, NUM_NODES>::Node) * (size_t)r.nodes;
+    return r;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the slots and payload heap of list's nodes.
+-----------------------------------------------------------------------*/
+
+/***** writeMemoryReport *****/
+template <typename Pool>
+void writeMemoryReport(std::ostream &os, const Pool &pool)
+{
+    PoolMemoryReport r = poolMemoryReport(pool);
+    os << "slot array:      " << r.slotBytes << " bytes (" << r.usedSlots << " used, "
+       << r.freeSlots << " free)\n"
+       << "index:           " << r.indexBytes << " bytes\n"
+       << "live heap:       " << r.liveHeapBytes << " bytes\n"
+       << "retained heap:   " << r.retainedHeapBytes << " bytes in " << r.retainingFreeSlots
+       << " free slots\n"
+       << "auxiliary heap:  " << r.auxHeapBytes << " bytes\n"
+       << "total:           " << r.totalBytes() << " bytes\n";
+
+    std::vector<OwnerMemoryReport> owners = ownerMemoryReport(pool);
+    for (size_t i = 0; i < owners.size(); ++i)
+    {
+        os << "  owner ";
+        if (owners[i].tag == SHARED_OWNER)
+            os << "shared";
+        else
+            os << (int)owners[i].tag;
+        os << ": " << owners[i].nodes << " nodes, " << owners[i].slotBytes << " slot bytes, "
+           << owners[i].heapBytes << " heap bytes\n";
+    }
+}
+/*----------------------------------------------------------------------
+  Precondition:  pool is a NodePool or StringNodePool.
+  Postcondition: The PoolMemoryReport and per-owner rows are written.
+-----------------------------------------------------------------------*/
+
+#endif // MEMORY_REPORT_H
@@ -6,24 +6,80 @@
 
   Basic operations are:
      Constructor:   Initialize the node pool and set up the free list.
+     reset:         Return every node to the free list.
      newNode:       Acquire a free node index directly (returns NULL_INDEX if none).
      acquire:       Mark a specific node index as used if it is currently free.
      deleteNode:    Return a node to the free list for reuse.
+     deleteChain:   Return a linked chain of nodes with one splice.
      operator[]:    Access nodes by index (modifiable and const versions).
+     node:          Unchecked access for chain traversal (checked with
+                    -DNODE_POOL_DEBUG).
+     handleOf:      NodeHandle (slot + generation) of a used node.
+     isLive:        O(1) check that a handle's node was not released.
      isNodeFree:    Check whether a node is in the free list.
      freeCount:     Count how many nodes are currently available.
      usedCount:     Count how many nodes are currently in use.
+     nextFree:      Index newNode will return next (NULL_INDEX if full).
      displayFree:   Print indices of nodes in the free list.
      displayUsed:   Print indices of nodes currently in use.
+     ownerOf:       Owner tag of a node (0 when free).
+     setOwner:      Re-tag a used node moved to another list.
+     registerOwner: Reserve an owner tag for a list (releaseOwner frees it).
+     nodes/owners:  Raw slot and owner-tag arrays for bulk scans.
+     checkChains:   Verify the free list and given list chains (e.g. after
+                    loading a pool from a file).
+
+  Every used node carries a one-byte owner tag, so the pool can tell
+  which slots are in use (and by which list) without walking the free
+  list.
+
+  With -DLIST_INSTRUMENTATION newNode / acquire / deleteNode count their
+  events in the Instrument.h counters (see listStatsReport).
 -------------------------------------------------------------------------*/
 
 #ifndef NODE_POOL_H
 #define NODE_POOL_H
 // using namespace std;
+#include "Instrument.h"
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 static const int NULL_INDEX = -1;
+static const unsigned char FREE_OWNER = 0;     // tag of a free node
+static const unsigned char SHARED_OWNER = 255; // used, owner not tracked
+
+// Pool and list operations are constexpr from C++20 on (for literal T),
+// so filled tables can be built at compile time; the instrumentation
+// hooks are not constexpr, so an instrumented build opts out
+#if __cplusplus >= 202002L && !defined(LIST_INSTRUMENTATION)
+#define POOL_CONSTEXPR constexpr
+#define POOL_HAS_CONSTEXPR 1
+#else
+#define POOL_CONSTEXPR
+#endif
+
+/***** NodeHandle *****/
+struct NodeHandle
+{
+    int slot;                // pool index, NULL_INDEX for no node
+    unsigned int generation; // generation of the slot when handed out
+
+    constexpr NodeHandle() : slot(NULL_INDEX), generation(0) {}
+    constexpr NodeHandle(int s, unsigned int g) : slot(s), generation(g) {}
+
+    constexpr explicit operator bool() const { return slot != NULL_INDEX; }
+    constexpr bool operator==(const NodeHandle &other) const
+    {
+        return slot == other.slot && generation == other.generation;
+    }
+    constexpr bool operator!=(const NodeHandle &other) const { return !(*this == other); }
+};
+/*----------------------------------------------------------------------
+  A reference to one node that notices reuse: every deleteNode bumps the
+  slot's generation, so a handle kept past the node's release no longer
+  matches (NodePool::isLive) even after the slot is handed out again.
+-----------------------------------------------------------------------*/
 
 template <typename T, int NUM_NODES>
 class NodePool
@@ -45,22 +101,33 @@ public:
     };
 
     /***** Class constructor *****/
-    NodePool();
+    POOL_CONSTEXPR NodePool();
     /*----------------------------------------------------------------------
       Construct a NodePool object.
 
       Precondition:  NUM_NODES must be a positive integer.
       Postcondition: All nodes are initialized and linked as a free list.
     -----------------------------------------------------------------------*/
-    int newNode();
+    /***** reset operation *****/
+    POOL_CONSTEXPR void reset();
+    /*----------------------------------------------------------------------
+      Free every node at once.
+
+      Precondition:  No list holds nodes of this pool any more.
+      Postcondition: All nodes are free and linked in index order; owner
+                     tags registered by lists stay reserved.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR int newNode(unsigned char ownerTag = SHARED_OWNER);
     /*----------------------------------------------------------------------
      return free node index.
 
      Precondition:  there must be a free node available.
-     Postcondition: Returns the index of a free node. Removes it from the pool.
+     Postcondition: Returns the index of a free node. Removes it from the pool
+                    and tags it with ownerTag.
    -----------------------------------------------------------------------*/
     /***** acquire operation *****/
-    bool acquire(int idx);
+    POOL_CONSTEXPR bool acquire(int idx, unsigned char ownerTag = SHARED_OWNER);
     /*----------------------------------------------------------------------
       Allocate a node from the free pool.
 
@@ -70,7 +137,7 @@ public:
     -----------------------------------------------------------------------*/
 
     /***** release operation *****/
-    void deleteNode(int);
+    POOL_CONSTEXPR void deleteNode(int);
     /*----------------------------------------------------------------------
       Return a node index back to the free pool.
 
@@ -79,10 +146,22 @@ public:
       Throws: std::out_of_range if idx is invalid.
     -----------------------------------------------------------------------*/
 
+    POOL_CONSTEXPR int deleteChain(int first);
+    /*----------------------------------------------------------------------
+      Return a whole chain of nodes (linked by next, ending in NULL_INDEX)
+      to the free pool with one splice.
+
+      Precondition:  Every node of the chain is in use and no longer
+                     linked from anywhere else.
+      Postcondition: Returns the number of nodes released; they head the
+                     free list in chain order.
+      Throws: std::out_of_range if the chain holds an invalid index.
+    -----------------------------------------------------------------------*/
+
     /***** subscript operator overloads *****/
-    Node &operator[](int idx);
+    POOL_CONSTEXPR Node &operator[](int idx);
 
-    const Node &operator[](int idx) const;
+    POOL_CONSTEXPR const Node &operator[](int idx) const;
     /*----------------------------------------------------------------------
       Provides access to nodes by index (modifiable and read-only versions).
 
@@ -91,8 +170,44 @@ public:
       Throws: std::out_of_range if idx is invalid.
     -----------------------------------------------------------------------*/
 
+    /***** unchecked access *****/
+    POOL_CONSTEXPR Node &node(int idx);
+
+    POOL_CONSTEXPR const Node &node(int idx) const;
+    /*----------------------------------------------------------------------
+      Access a node without the range check of operator[], for indices
+      taken from a chain (a head or a next link) that are valid by
+      construction. Build with -DNODE_POOL_DEBUG to check them as well.
+
+      Precondition:  0 <= idx < NUM_NODES.
+      Postcondition: Returns a reference to the node at idx.
+      Throws: std::out_of_range if idx is invalid (NODE_POOL_DEBUG only).
+    -----------------------------------------------------------------------*/
+
+    /***** handle operations *****/
+    POOL_CONSTEXPR NodeHandle handleOf(int idx) const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns a handle to the used node idx, or a null
+                     handle if idx is out of range or free.
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR bool isLive(NodeHandle h) const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: True iff h's slot is in range and in use, and has not
+                     been released since h was handed out. O(1).
+    -----------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR unsigned int generationOf(int idx) const;
+    /*----------------------------------------------------------------------
+      Precondition:  idx is a valid index.
+      Postcondition: Returns how often node idx has been released (mod 2^32).
+      Throws: std::out_of_range if idx is invalid.
+    -----------------------------------------------------------------------*/
+
     /***** freeCount operation *****/
-    int freeCount() const;
+    POOL_CONSTEXPR int freeCount() const;
     /*----------------------------------------------------------------------
       Count the number of nodes currently available in the pool.
 
@@ -101,7 +216,7 @@ public:
     -----------------------------------------------------------------------*/
 
     /***** usedCount operation *****/
-    int usedCount() const;
+    POOL_CONSTEXPR int usedCount() const;
     /*----------------------------------------------------------------------
       Count the number of nodes currently used in the pool.
 
@@ -109,8 +224,17 @@ public:
       Postcondition: Returns the number of used nodes.
     -----------------------------------------------------------------------*/
 
+    /***** nextFree operation *****/
+    POOL_CONSTEXPR int nextFree() const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns the index the next newNode call will hand
+                     out, i.e. the most recently freed node, or NULL_INDEX
+                     if the pool is full.
+    -----------------------------------------------------------------------*/
+
     /***** isNodeFree operation *****/
-    bool isNodeFree(int idx) const;
+    POOL_CONSTEXPR bool isNodeFree(int idx) const;
     /*----------------------------------------------------------------------
       Check whether a node at a given index is free in the node pool.
 
@@ -119,6 +243,61 @@ public:
                      free (i.e., present in the free list); false otherwise.
     ------------------------------------------------------------------------*/
 
+    /***** owner tag operations *****/
+    POOL_CONSTEXPR unsigned char ownerOf(int idx) const;
+    POOL_CONSTEXPR void setOwner(int idx, unsigned char ownerTag);
+    /*----------------------------------------------------------------------
+      Read or change the owner tag of a node.
+
+      Precondition:  idx is a valid index; setOwner only on a used node.
+      Postcondition: ownerOf returns FREE_OWNER for free nodes.
+    ------------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR unsigned char registerOwner();
+    POOL_CONSTEXPR void releaseOwner(unsigned char ownerTag);
+    /*----------------------------------------------------------------------
+      Reserve / release a distinct owner tag for one list.
+
+      Precondition:  None
+      Postcondition: registerOwner returns a tag in [1, 254], or
+                     SHARED_OWNER once all tags are taken.
+    ------------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR void resetOwners();
+    /*----------------------------------------------------------------------
+      Forget every registered owner tag (used when a pool outlives the
+      process that filled it, e.g. a mapped file).
+
+      Precondition:  No list is registered with this pool.
+      Postcondition: No tag is reserved; used nodes carry SHARED_OWNER
+                     until a list attaches them.
+    ------------------------------------------------------------------------*/
+
+    POOL_CONSTEXPR const Node *nodes() const;
+    POOL_CONSTEXPR const unsigned char *owners() const;
+    /*----------------------------------------------------------------------
+      Raw access to the slot array and the parallel owner-tag array.
+
+      Precondition:  None
+      Postcondition: Both arrays have NUM_NODES entries.
+    ------------------------------------------------------------------------*/
+
+    /***** checkChains operation *****/
+    const char *checkChains(const int *heads, int headCount) const;
+    /*----------------------------------------------------------------------
+      Check the pool's links against the chains starting at heads, e.g.
+      before trusting a pool read from a file.
+
+      Precondition:  heads holds headCount list heads (NULL_INDEX for an
+                     empty list).
+      Postcondition: Returns 0 if every index is in range, the free list
+                     and each chain end without a cycle, no node is on two
+                     chains, chain nodes are used and free-list nodes are
+                     free, and together they cover exactly the used and
+                     free counts; otherwise a short description of the
+                     first problem found. O(NUM_NODES); nothing is changed.
+    ------------------------------------------------------------------------*/
+
     /***** displayFree operation *****/
     void displayFree(std::ostream &os) const;
     /*----------------------------------------------------------------------
@@ -140,48 +319,76 @@ public:
     ------------------------------------------------------------------------*/
 
 private:
+    template <typename, int>
+    friend class PoolSnapshot; // bulk save/load of the raw arrays
+
     /******** Data Members ********/
-    Node pool[NUM_NODES]; ///< Array of node
-    int freeHead;         ///< Index of the head of the free list
+    Node pool[NUM_NODES];                ///< Array of node
+    unsigned char owner[NUM_NODES];      ///< Owner tag per node (0 = free)
+    unsigned int generation[NUM_NODES];  ///< Releases per node (handles)
+    unsigned long long ownerInUse[4];    ///< Registered owner tags
+    int freeHead;                        ///< Index of the head of the free list
+    int used;                            ///< Number of nodes in use
 
 }; //--- end of NodePool class
 
 /***** Implementation Section *****/
 
 template <typename T, int NUM_NODES>
-NodePool<T, NUM_NODES>::NodePool()
+POOL_CONSTEXPR NodePool<T, NUM_NODES>::NodePool()
+    : pool(), owner(), generation(), ownerInUse(), freeHead(0), used(0)
+{
+    reset();
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void NodePool<T, NUM_NODES>::reset()
 {
     for (int i = 0; i < NUM_NODES - 1; ++i)
         pool[i].next = i + 1;
     pool[NUM_NODES - 1].next = NULL_INDEX;
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        if (owner[i] != FREE_OWNER)
+            ++generation[i]; // handles to released nodes go stale
+        owner[i] = FREE_OWNER;
+    }
     freeHead = 0;
+    used = 0;
 }
 
 template <typename T, int NUM_NODES>
-int NodePool<T, NUM_NODES>::newNode()
+POOL_CONSTEXPR int NodePool<T, NUM_NODES>::newNode(unsigned char ownerTag)
 {
     if (freeHead == NULL_INDEX)
+    {
+        POOL_EVENT(poolFull);
         return NULL_INDEX;
+    }
+    POOL_EVENT(poolAlloc);
     int idx = freeHead;
     freeHead = pool[idx].next;
     pool[idx].next = NULL_INDEX;
+    owner[idx] = ownerTag;
+    ++used;
     return idx;
 }
 template <typename T, int NUM_NODES>
-bool NodePool<T, NUM_NODES>::isNodeFree(int idx) const
+POOL_CONSTEXPR int NodePool<T, NUM_NODES>::nextFree() const
 {
-    int ptr = freeHead;
-    while (ptr != NULL_INDEX)
-    {
-        if (ptr == idx)
-            return true;
-        ptr = pool[ptr].next;
-    }
-    return false;
+    return freeHead;
 }
 
 template <typename T, int NUM_NODES>
-bool NodePool<T, NUM_NODES>::acquire(int idx)
+POOL_CONSTEXPR bool NodePool<T, NUM_NODES>::isNodeFree(int idx) const
+{
+    if (idx < 0 || idx >= NUM_NODES)
+        return false;
+    return owner[idx] == FREE_OWNER;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool NodePool<T, NUM_NODES>::acquire(int idx, unsigned char ownerTag)
 {
 
     // Validate index range
@@ -190,15 +397,23 @@ bool NodePool<T, NUM_NODES>::acquire(int idx)
         throw std::out_of_range("acquire: index out of range");
         return false;
     }
+    if (owner[idx] != FREE_OWNER)
+    {
+        POOL_EVENT(poolAcquireMiss);
+        return false; // already in use, no need to walk the free list
+    }
     int prev = NULL_INDEX; // Previous node in the free list
     int cur = freeHead;    // Current node in traversal
 
     // Traverse the free list to find the node with the given index
+    int walked = 0;
     while (cur != NULL_INDEX && cur != idx)
     {
         prev = cur;
         cur = pool[cur].next;
+        ++walked;
     }
+    POOL_HOPS(walked);
 
     // If idx is not found in the free list, it’s already in use
     if (cur == NULL_INDEX)
@@ -210,20 +425,49 @@ bool NodePool<T, NUM_NODES>::acquire(int idx)
     else
         pool[prev].next = pool[cur].next; // idx is in the middle or end
     pool[cur].next = NULL_INDEX;          // Disconnect node from free list
+    POOL_EVENT(poolAlloc);
+    owner[cur] = ownerTag;
+    ++used;
     return true;                          // Node successfully acquired
 }
 
 template <typename T, int NUM_NODES>
-void NodePool<T, NUM_NODES>::deleteNode(int idx)
+POOL_CONSTEXPR void NodePool<T, NUM_NODES>::deleteNode(int idx)
 {
     if (idx < 0 || idx >= NUM_NODES)
         throw std::out_of_range("deleteNode: index out of range");
+    POOL_EVENT(poolFree);
+    ++generation[idx];
     pool[idx].next = freeHead;
     freeHead = idx;
+    owner[idx] = FREE_OWNER;
+    --used;
 }
 
 template <typename T, int NUM_NODES>
-typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](int idx)
+POOL_CONSTEXPR int NodePool<T, NUM_NODES>::deleteChain(int first)
+{
+    if (first == NULL_INDEX)
+        return 0;
+    int count = 0, last = first;
+    for (int idx = first; idx != NULL_INDEX; idx = pool[idx].next)
+    {
+        if (idx < 0 || idx >= NUM_NODES)
+            throw std::out_of_range("deleteChain: index out of range");
+        ++generation[idx];
+        owner[idx] = FREE_OWNER;
+        last = idx;
+        ++count;
+    }
+    POOL_EVENTS(poolFree, count);
+    pool[last].next = freeHead;
+    freeHead = first;
+    used -= count;
+    return count;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](int idx)
 {
     if (idx < 0 || idx >= NUM_NODES)
         throw std::out_of_range("NodePool::operator[]");
@@ -231,7 +475,7 @@ typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](int id
 }
 
 template <typename T, int NUM_NODES>
-const typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](int idx) const
+POOL_CONSTEXPR const typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](int idx) const
 {
     if (idx < 0 || idx >= NUM_NODES)
         throw std::out_of_range("NodePool::operator[]");
@@ -239,22 +483,166 @@ const typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::operator[](
 }
 
 template <typename T, int NUM_NODES>
-int NodePool<T, NUM_NODES>::freeCount() const
+POOL_CONSTEXPR typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::node(int idx)
+{
+#ifdef NODE_POOL_DEBUG
+    if (idx < 0 || idx >= NUM_NODES)
+        throw std::out_of_range("NodePool::node");
+#endif
+    return pool[idx];
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR const typename NodePool<T, NUM_NODES>::Node &NodePool<T, NUM_NODES>::node(int idx) const
+{
+#ifdef NODE_POOL_DEBUG
+    if (idx < 0 || idx >= NUM_NODES)
+        throw std::out_of_range("NodePool::node");
+#endif
+    return pool[idx];
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR NodeHandle NodePool<T, NUM_NODES>::handleOf(int idx) const
+{
+    if (idx < 0 || idx >= NUM_NODES || owner[idx] == FREE_OWNER)
+        return NodeHandle();
+    return NodeHandle(idx, generation[idx]);
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR bool NodePool<T, NUM_NODES>::isLive(NodeHandle h) const
+{
+    return h.slot >= 0 && h.slot < NUM_NODES && owner[h.slot] != FREE_OWNER &&
+           generation[h.slot] == h.generation;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR unsigned int NodePool<T, NUM_NODES>::generationOf(int idx) const
+{
+    if (idx < 0 || idx >= NUM_NODES)
+        throw std::out_of_range("generationOf: index out of range");
+    return generation[idx];
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int NodePool<T, NUM_NODES>::freeCount() const
+{
+    return NUM_NODES - used;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR int NodePool<T, NUM_NODES>::usedCount() const
+{
+    return used;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR unsigned char NodePool<T, NUM_NODES>::ownerOf(int idx) const
+{
+    if (idx < 0 || idx >= NUM_NODES)
+        throw std::out_of_range("ownerOf: index out of range");
+    return owner[idx];
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void NodePool<T, NUM_NODES>::setOwner(int idx, unsigned char ownerTag)
+{
+    if (idx < 0 || idx >= NUM_NODES)
+        throw std::out_of_range("setOwner: index out of range");
+    owner[idx] = ownerTag;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR unsigned char NodePool<T, NUM_NODES>::registerOwner()
 {
-    int count = 0;
-    int ptr = freeHead;
-    while (ptr != NULL_INDEX)
+    for (int tag = 1; tag < SHARED_OWNER; ++tag)
     {
-        ptr = pool[ptr].next;
-        ++count;
+        unsigned long long bit = 1ULL << (tag % 64);
+        if (!(ownerInUse[tag / 64] & bit))
+        {
+            ownerInUse[tag / 64] |= bit;
+            return (unsigned char)tag;
+        }
+    }
+    return SHARED_OWNER;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void NodePool<T, NUM_NODES>::releaseOwner(unsigned char ownerTag)
+{
+    if (ownerTag != FREE_OWNER && ownerTag != SHARED_OWNER)
+        ownerInUse[ownerTag / 64] &= ~(1ULL << (ownerTag % 64));
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR void NodePool<T, NUM_NODES>::resetOwners()
+{
+    for (int w = 0; w < 4; ++w)
+        ownerInUse[w] = 0;
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        if (owner[i] != FREE_OWNER)
+            owner[i] = SHARED_OWNER;
     }
-    return count;
 }
 
 template <typename T, int NUM_NODES>
-int NodePool<T, NUM_NODES>::usedCount() const
+POOL_CONSTEXPR const typename NodePool<T, NUM_NODES>::Node *NodePool<T, NUM_NODES>::nodes() const
 {
-    return NUM_NODES - freeCount();
+    return pool;
+}
+
+template <typename T, int NUM_NODES>
+POOL_CONSTEXPR const unsigned char *NodePool<T, NUM_NODES>::owners() const
+{
+    return owner;
+}
+
+template <typename T, int NUM_NODES>
+const char *NodePool<T, NUM_NODES>::checkChains(const int *heads, int headCount) const
+{
+    if (freeHead < NULL_INDEX || freeHead >= NUM_NODES || used < 0 || used > NUM_NODES)
+        return "corrupt pool header";
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        if (pool[i].next < NULL_INDEX || pool[i].next >= NUM_NODES)
+            return "corrupt next index";
+    }
+
+    // Every slot may be visited once in total, whichever chain it is on
+    std::vector<bool> seen(NUM_NODES, false);
+    int freeNodes = 0;
+    for (int ptr = freeHead; ptr != NULL_INDEX; ptr = pool[ptr].next)
+    {
+        if (seen[ptr])
+            return "cycle in the free list";
+        if (owner[ptr] != FREE_OWNER)
+            return "used node on the free list";
+        seen[ptr] = true;
+        ++freeNodes;
+    }
+    if (freeNodes != NUM_NODES - used)
+        return "free list length does not match the used count";
+
+    int listNodes = 0;
+    for (int h = 0; h < headCount; ++h)
+    {
+        if (heads[h] < NULL_INDEX || heads[h] >= NUM_NODES)
+            return "corrupt list head";
+        for (int ptr = heads[h]; ptr != NULL_INDEX; ptr = pool[ptr].next)
+        {
+            if (owner[ptr] == FREE_OWNER)
+                return "list node is marked free";
+            if (seen[ptr])
+                return "list node is shared or on a cycle";
+            seen[ptr] = true;
+            ++listNodes;
+        }
+    }
+    if (listNodes != used)
+        return "lists do not hold every used node";
+    return 0;
 }
 
 template <typename T, int NUM_NODES>
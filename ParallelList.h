@@ -0,0 +1,196 @@
+/*-- ParallelList.h --------------------------------------------------------
+
+  This header file defines order-independent bulk algorithms over an
+  ArrayLinkedList that run on the shared ThreadPool.
+
+  Work is split by pool slot: when the list has its own owner tag each
+  task takes a contiguous range of the NodePool array and keeps the slots
+  carrying that tag, so no thread chases next indices. Lists without a
+  tag (SHARED_OWNER) are first walked once into a slot vector, which is
+  then split. Small pools stay on the serial path.
+
+  Basic operations are:
+     parallelForEach(list, f)          – call f(value&) for every element
+     parallelTransform(list, f)        – value = f(value) for every element
+     parallelReduce(list, init, op)    – fold elements with op
+     parallelCountIf(list, pred)       – count elements satisfying pred
+
+  Callables run concurrently on different elements and in no particular
+  order; op of parallelReduce must be associative and commutative.
+-------------------------------------------------------------------------*/
+
+#ifndef PARALLEL_LIST_H
+#define PARALLEL_LIST_H
+
+#include "List.h"
+#include "ThreadPool.h"
+#include <vector>
+
+static const int PARALLEL_CUTOFF = 4096; // used slots below this run serially
+static const int PARALLEL_TASKS_PER_THREAD = 4;
+
+/***** parallelVisitSlots helper *****/
+template <typename T, int NUM_NODES, typename Visit>
+int parallelVisitSlots(const ArrayLinkedList<T, NUM_NODES> &list, Visit visit)
+{
+    const NodePool<T, NUM_NODES> &pool = list.getPool();
+    unsigned char tag = list.getOwnerTag();
+    ThreadPool &threads = ThreadPool::shared();
+    int tasks = threads.size() * PARALLEL_TASKS_PER_THREAD;
+
+    if (tag != SHARED_OWNER)
+    {
+        const unsigned char *owners = pool.owners();
+        threads.parallelFor(tasks, [&](int t) {
+            int lo = (int)((long long)NUM_NODES * t / tasks);
+            int hi = (int)((long long)NUM_NODES * (t + 1) / tasks);
+            for (int i = lo; i < hi; ++i)
+            {
+                if (owners[i] == tag)
+                    visit(t, i);
+            }
+        });
+        return tasks;
+    }
+
+    std::vector<int> slots;
+    for (int ptr = list.getHead(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+        slots.push_back(ptr);
+    int count = (int)slots.size();
+    threads.parallelFor(tasks, [&](int t) {
+        int lo = (int)((long long)count * t / tasks);
+        int hi = (int)((long long)count * (t + 1) / tasks);
+        for (int k = lo; k < hi; ++k)
+            visit(t, slots[k]);
+    });
+    return tasks;
+}
+/*----------------------------------------------------------------------
+  Call visit(task, slot) for every slot of list, split across the pool.
+
+  Precondition:  visit only touches data owned by its task or the slot.
+  Postcondition: Returns the number of tasks used (task ids are below it).
+-----------------------------------------------------------------------*/
+
+template <typename T, int NUM_NODES>
+bool parallelWorthIt(const ArrayLinkedList<T, NUM_NODES> &list)
+{
+    return list.getPool().usedCount() >= PARALLEL_CUTOFF && ThreadPool::shared().size() > 1;
+}
+
+/***** parallelForEach *****/
+template <typename T, int NUM_NODES, typename Func>
+void parallelForEach(ArrayLinkedList<T, NUM_NODES> &list, Func f)
+{
+    NodePool<T, NUM_NODES> &pool = list.getPool();
+    if (!parallelWorthIt(list))
+    {
+        for (int ptr = list.getHead(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+            f(pool.node(ptr).data);
+        return;
+    }
+    parallelVisitSlots(list, [&](int, int slot) { f(pool.node(slot).data); });
+}
+/*----------------------------------------------------------------------
+  Precondition:  f is callable as f(T&) and safe to run concurrently.
+  Postcondition: f has been applied to every element.
+-----------------------------------------------------------------------*/
+
+/***** parallelTransform *****/
+template <typename T, int NUM_NODES, typename Func>
+void parallelTransform(ArrayLinkedList<T, NUM_NODES> &list, Func f)
+{
+    parallelForEach(list, [&f](T &value) { value = f(value); });
+}
+/*----------------------------------------------------------------------
+  Precondition:  f is callable as T f(const T&).
+  Postcondition: Every element is replaced by f(element).
+-----------------------------------------------------------------------*/
+
+/***** parallelReduce *****/
+template <typename T, int NUM_NODES, typename R, typename Op>
+R parallelReduce(const ArrayLinkedList<T, NUM_NODES> &list, R init, Op op)
+{
+    const NodePool<T, NUM_NODES> &pool = list.getPool();
+    if (!parallelWorthIt(list))
+    {
+        for (int ptr = list.getHead(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+            init = op(init, pool.node(ptr).data);
+        return init;
+    }
+
+    // One cache line per task so partial results do not false-share
+    struct alignas(64) Partial
+    {
+        R value;
+        bool used;
+    };
+    std::vector<Partial> partials(ThreadPool::shared().size() * PARALLEL_TASKS_PER_THREAD);
+    for (size_t t = 0; t < partials.size(); ++t)
+        partials[t].used = false;
+
+    parallelVisitSlots(list, [&](int t, int slot) {
+        Partial &p = partials[t];
+        if (p.used)
+            p.value = op(p.value, pool.node(slot).data);
+        else
+        {
+            p.value = pool.node(slot).data;
+            p.used = true;
+        }
+    });
+
+    for (size_t t = 0; t < partials.size(); ++t)
+    {
+        if (partials[t].used)
+            init = op(init, partials[t].value);
+    }
+    return init;
+}
+/*----------------------------------------------------------------------
+  Precondition:  op(R, T) and op(R, R) return R; op is associative and
+                 commutative; R is default-constructible and T converts
+                 to R.
+  Postcondition: Returns init combined with every element.
+-----------------------------------------------------------------------*/
+
+/***** parallelCountIf *****/
+template <typename T, int NUM_NODES, typename Pred>
+int parallelCountIf(const ArrayLinkedList<T, NUM_NODES> &list, Pred pred)
+{
+    const NodePool<T, NUM_NODES> &pool = list.getPool();
+    if (!parallelWorthIt(list))
+    {
+        int count = 0;
+        for (int ptr = list.getHead(); ptr != NULL_INDEX; ptr = pool.node(ptr).next)
+        {
+            if (pred(pool.node(ptr).data))
+                ++count;
+        }
+        return count;
+    }
+
+    struct alignas(64) Counter
+    {
+        int value;
+    };
+    std::vector<Counter> counters(ThreadPool::shared().size() * PARALLEL_TASKS_PER_THREAD);
+    for (size_t t = 0; t < counters.size(); ++t)
+        counters[t].value = 0;
+
+    parallelVisitSlots(list, [&](int t, int slot) {
+        if (pred(pool.node(slot).data))
+            ++counters[t].value;
+    });
+
+    int count = 0;
+    for (size_t t = 0; t < counters.size(); ++t)
+        count += counters[t].value;
+    return count;
+}
+/*----------------------------------------------------------------------
+  Precondition:  pred is callable as bool pred(const T&).
+  Postcondition: Returns the number of elements for which pred is true.
+-----------------------------------------------------------------------*/
+
+#endif // PARALLEL_LIST_H
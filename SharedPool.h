@@ -0,0 +1,548 @@
+/*-- SharedPool.h ----------------------------------------------------------
+
+  This header file defines the template classes SharedNodePool and
+  SharedList, which place a NodePool and a table of named list heads in a
+  POSIX shared memory segment so several processes can work on the same
+  lists without serializing or copying anything.
+
+  This works because links are slot indices: each process may map the
+  segment at a different address and the chains stay valid. One
+  process-shared (robust) mutex protects the pool and every list.
+
+  Segment layout:
+     SharedPoolHeader   magic, layout checks, mutex, named list heads
+     (padding to 64 bytes)
+     NodePool<T, N>     the pool object itself
+
+  Basic SharedNodePool operations are:
+     Constructor:   Open the segment, creating and formatting it if needed.
+     Destructor:    Unmap (the segment stays until unlink).
+     unlink:        Remove a segment name (static).
+     pool:          The shared NodePool (use under lock()).
+     lock/unlock:   The process-shared mutex (BasicLockable).
+     list:          Handle to a named list, created on first use.
+
+  Basic SharedList operations (each takes the lock once) are:
+     apply:         Run f(ArrayLinkedList&) on the list under the lock.
+     insertFront, insertBack, popFront, size, contains
+
+  Each list entry also caches its tail, so insertBack + popFront make an
+  O(1) FIFO queue; apply (which may change anything) forgets the tail
+  and the next insertBack walks the list once to find it.
+
+  Link with -pthread (and -lrt on glibc older than 2.34).
+-------------------------------------------------------------------------*/
+
+#ifndef SHARED_POOL_H
+#define SHARED_POOL_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const int SHARED_MAX_LISTS = 16;
+static const int SHARED_NAME_LEN = 32;
+static const unsigned int SHARED_POOL_VERSION = 2; // 2: cached list tails
+static const int SHARED_OPEN_WAIT_MS = 5000; // wait for a concurrent creator
+
+/***** SharedListEntry *****/
+struct SharedListEntry
+{
+    char name[SHARED_NAME_LEN]; // "" when the entry is unused
+    int head;
+    int tail;                   // last node, NULL_INDEX when not known
+    unsigned char tag;          // owner tag reserved in the shared pool
+};
+
+/***** SharedPoolHeader *****/
+struct SharedPoolHeader
+{
+    char magic[8];                      // "NPOOLSHM"
+    unsigned int version;               // SHARED_POOL_VERSION
+    unsigned int numNodes;              // NUM_NODES
+    unsigned int nodeSize;              // sizeof(Node)
+    unsigned long long poolSize;        // sizeof(NodePool<T, N>)
+    std::atomic<unsigned int> ready;    // set once the creator is done
+    pthread_mutex_t lock;               // PTHREAD_PROCESS_SHARED, robust
+    SharedListEntry lists[SHARED_MAX_LISTS];
+};
+
+template <typename T, int NUM_NODES>
+class SharedNodePool;
+
+/***** SharedList class *****/
+template <typename T, int NUM_NODES>
+class SharedList
+{
+public:
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+
+    template <typename Func>
+    void apply(Func f);
+    /*----------------------------------------------------------------------
+      Run f on the list while holding the segment lock.
+
+      Precondition:  f is callable as f(ArrayLinkedList<T, N>&) and does
+                     not keep the reference; f must not fill the pool
+                     (insert* would prompt) – check pool freeCount first.
+      Postcondition: The list head is written back to the segment, also
+                     when f throws.
+    -----------------------------------------------------------------------*/
+
+    bool insertFront(const T &value);
+    bool insertBack(const T &value);
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns false (without prompting) if the pool is
+                     full; otherwise value is inserted. insertBack is O(1)
+                     while the cached tail is known.
+    -----------------------------------------------------------------------*/
+
+    bool popFront(T &value);
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns false if the list is empty; otherwise the
+                     first element is moved to value and its node freed.
+    -----------------------------------------------------------------------*/
+
+    int size();
+    bool contains(const T &value);
+
+private:
+    friend class SharedNodePool<T, NUM_NODES>;
+    SharedList(SharedNodePool<T, NUM_NODES> &s, int e) : shared(&s), entry(e) {}
+
+    template <typename Func>
+    void update(Func f);
+    /*----------------------------------------------------------------------
+      apply for the members: f(list, entry) must leave entry.tail either
+      correct or NULL_INDEX. A throw from f forgets the tail.
+    -----------------------------------------------------------------------*/
+
+    /******** Data Members ********/
+    SharedNodePool<T, NUM_NODES> *shared;
+    int entry; // index into SharedPoolHeader::lists
+
+}; //--- end of SharedList class
+
+/***** SharedNodePool class *****/
+template <typename T, int NUM_NODES>
+class SharedNodePool
+{
+public:
+    typedef NodePool<T, NUM_NODES> Pool;
+
+    /***** Class constructor *****/
+    explicit SharedNodePool(const std::string &name);
+    /*----------------------------------------------------------------------
+      Open the shared memory segment name ("/something"), creating and
+      formatting it if it does not exist yet.
+
+      Precondition:  None
+      Postcondition: pool() and the named lists are usable. A process that
+                     opens while another creates waits for it to finish.
+      Throws: std::runtime_error on errors or a layout mismatch.
+    -----------------------------------------------------------------------*/
+
+    /***** Class destructor *****/
+    ~SharedNodePool();
+    /*----------------------------------------------------------------------
+      Precondition:  The lock is not held by this process.
+      Postcondition: The segment is unmapped; its contents stay available
+                     to other processes until unlink(name).
+    -----------------------------------------------------------------------*/
+
+    static bool unlink(const std::string &name);
+
+    Pool &pool();
+    bool created() const;
+
+    void lock();
+    void unlock();
+    /*----------------------------------------------------------------------
+      Precondition:  unlock only by the process holding the lock.
+      Postcondition: If the previous holder died while holding it, the
+                     named lists are checked with checkChains; if they add
+                     up the mutex is marked consistent and the lock is
+                     acquired.
+      Throws: std::runtime_error if they do not (the mutex is left
+              unrecoverable, so every later lock() throws too: the
+              segment has to be unlinked and rebuilt).
+    -----------------------------------------------------------------------*/
+
+    SharedList<T, NUM_NODES> list(const std::string &listName);
+    /*----------------------------------------------------------------------
+      Get the list called listName, creating an empty one if needed.
+
+      Precondition:  listName is 1..SHARED_NAME_LEN-1 characters.
+      Postcondition: Returns a handle usable from any process that maps
+                     this segment.
+      Throws: std::length_error for a bad name, std::runtime_error if all
+              SHARED_MAX_LISTS entries are taken.
+    -----------------------------------------------------------------------*/
+
+private:
+    SharedNodePool(const SharedNodePool &);
+    SharedNodePool &operator=(const SharedNodePool &);
+
+    friend class SharedList<T, NUM_NODES>;
+
+    static size_t poolOffset();
+    void format();
+    void fail(const std::string &what);
+
+    /******** Data Members ********/
+    int fd;
+    void *base;
+    size_t mappedBytes;
+    bool fresh;
+    SharedPoolHeader *header;
+    Pool *sharedPool;
+
+}; //--- end of SharedNodePool class
+
+/***** Implementation Section *****/
+
+template <typename T, int NUM_NODES>
+size_t SharedNodePool<T, NUM_NODES>::poolOffset()
+{
+    return (sizeof(SharedPoolHeader) + 63) / 64 * 64;
+}
+
+template <typename T, int NUM_NODES>
+void SharedNodePool<T, NUM_NODES>::fail(const std::string &what)
+{
+    int err = errno;
+    if (base != 0)
+        ::munmap(base, mappedBytes);
+    if (fd >= 0)
+        ::close(fd);
+    base = 0;
+    fd = -1;
+    throw std::runtime_error("shared pool: " + what + (err ? std::string(": ") + std::strerror(err) : ""));
+}
+
+template <typename T, int NUM_NODES>
+SharedNodePool<T, NUM_NODES>::SharedNodePool(const std::string &name)
+    : fd(-1), base(0), mappedBytes(poolOffset() + sizeof(Pool)), fresh(false),
+      header(0), sharedPool(0)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SharedNodePool needs a trivially copyable payload");
+    static_assert(alignof(Pool) <= 64, "pool alignment exceeds header padding");
+
+    fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    fresh = (fd >= 0);
+    if (!fresh)
+    {
+        if (errno != EEXIST)
+            fail("cannot create " + name);
+        fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0)
+            fail("cannot open " + name);
+    }
+
+    if (fresh)
+    {
+        if (::ftruncate(fd, (off_t)mappedBytes) != 0)
+            fail("cannot size " + name);
+    }
+    else
+    {
+        // The creator may still be between shm_open and ftruncate
+        struct stat st;
+        int waited = 0;
+        for (;;)
+        {
+            if (::fstat(fd, &st) != 0)
+                fail("cannot stat " + name);
+            if (st.st_size != 0 || waited >= SHARED_OPEN_WAIT_MS)
+                break;
+            ::usleep(1000);
+            ++waited;
+        }
+        if ((size_t)st.st_size != mappedBytes)
+        {
+            errno = 0;
+            fail("segment size does not match pool layout");
+        }
+    }
+
+    base = ::mmap(0, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        base = 0;
+        fail("mmap failed for " + name);
+    }
+
+    if (fresh)
+    {
+        format();
+        return;
+    }
+
+    header = std::launder(static_cast<SharedPoolHeader *>(base));
+    for (int waited = 0; header->ready.load(std::memory_order_acquire) == 0; ++waited)
+    {
+        if (waited >= SHARED_OPEN_WAIT_MS)
+        {
+            errno = 0;
+            fail("timed out waiting for " + name + " to be formatted");
+        }
+        ::usleep(1000);
+    }
+    if (std::memcmp(header->magic, "NPOOLSHM", sizeof(header->magic)) != 0 ||
+        header->version != SHARED_POOL_VERSION || header->numNodes != (unsigned)NUM_NODES ||
+        header->nodeSize != sizeof(typename Pool::Node) || header->poolSize != sizeof(Pool))
+    {
+        errno = 0;
+        fail("pool layout does not match");
+    }
+    sharedPool = std::launder(reinterpret_cast<Pool *>(static_cast<char *>(base) + poolOffset()));
+}
+
+template <typename T, int NUM_NODES>
+void SharedNodePool<T, NUM_NODES>::format()
+{
+    header = new (base) SharedPoolHeader;
+    std::memcpy(header->magic, "NPOOLSHM", sizeof(header->magic));
+    header->version = SHARED_POOL_VERSION;
+    header->numNodes = NUM_NODES;
+    header->nodeSize = sizeof(typename Pool::Node);
+    header->poolSize = sizeof(Pool);
+    for (int i = 0; i < SHARED_MAX_LISTS; ++i)
+    {
+        header->lists[i].name[0] = '\0';
+        header->lists[i].head = NULL_INDEX;
+        header->lists[i].tail = NULL_INDEX;
+        header->lists[i].tag = SHARED_OWNER;
+    }
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    int rc = pthread_mutex_init(&header->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (rc != 0)
+    {
+        errno = rc;
+        fail("cannot initialise the shared mutex");
+    }
+
+    sharedPool = new (static_cast<char *>(base) + poolOffset()) Pool();
+    header->ready.store(1, std::memory_order_release);
+}
+
+template <typename T, int NUM_NODES>
+SharedNodePool<T, NUM_NODES>::~SharedNodePool()
+{
+    if (base != 0)
+        ::munmap(base, mappedBytes);
+    if (fd >= 0)
+        ::close(fd);
+}
+
+template <typename T, int NUM_NODES>
+bool SharedNodePool<T, NUM_NODES>::unlink(const std::string &name)
+{
+    return ::shm_unlink(name.c_str()) == 0;
+}
+
+template <typename T, int NUM_NODES>
+typename SharedNodePool<T, NUM_NODES>::Pool &SharedNodePool<T, NUM_NODES>::pool()
+{
+    return *sharedPool;
+}
+
+template <typename T, int NUM_NODES>
+bool SharedNodePool<T, NUM_NODES>::created() const
+{
+    return fresh;
+}
+
+template <typename T, int NUM_NODES>
+void SharedNodePool<T, NUM_NODES>::lock()
+{
+    int rc = pthread_mutex_lock(&header->lock);
+    if (rc == EOWNERDEAD)
+    {
+        // The holder died; only trust the lists if their links add up
+        int heads[SHARED_MAX_LISTS];
+        for (int i = 0; i < SHARED_MAX_LISTS; ++i)
+            heads[i] = header->lists[i].name[0] != '\0' ? header->lists[i].head : NULL_INDEX;
+        const char *problem = sharedPool->checkChains(heads, SHARED_MAX_LISTS);
+        if (problem)
+        {
+            // Unlocking without pthread_mutex_consistent makes the mutex
+            // unrecoverable, so every later lock() fails as well
+            pthread_mutex_unlock(&header->lock);
+            throw std::runtime_error(std::string("shared pool: holder died mid-update: ") + problem);
+        }
+        for (int i = 0; i < SHARED_MAX_LISTS; ++i)
+            header->lists[i].tail = NULL_INDEX; // may predate the last link
+        pthread_mutex_consistent(&header->lock);
+    }
+    else if (rc == ENOTRECOVERABLE)
+        throw std::runtime_error("shared pool: lock is unrecoverable after a failed update");
+    else if (rc != 0)
+        throw std::runtime_error("shared pool: lock failed");
+}
+
+template <typename T, int NUM_NODES>
+void SharedNodePool<T, NUM_NODES>::unlock()
+{
+    pthread_mutex_unlock(&header->lock);
+}
+
+template <typename T, int NUM_NODES>
+SharedList<T, NUM_NODES> SharedNodePool<T, NUM_NODES>::list(const std::string &listName)
+{
+    if (listName.empty() || listName.size() >= (size_t)SHARED_NAME_LEN)
+        throw std::length_error("SharedNodePool::list: bad list name");
+
+    std::lock_guard<SharedNodePool> guard(*this);
+    int freeEntry = -1;
+    for (int i = 0; i < SHARED_MAX_LISTS; ++i)
+    {
+        SharedListEntry &e = header->lists[i];
+        if (e.name[0] == '\0')
+        {
+            if (freeEntry < 0)
+                freeEntry = i;
+        }
+        else if (listName == e.name)
+            return SharedList<T, NUM_NODES>(*this, i);
+    }
+    if (freeEntry < 0)
+        throw std::runtime_error("SharedNodePool::list: list table is full");
+
+    SharedListEntry &e = header->lists[freeEntry];
+    std::memcpy(e.name, listName.c_str(), listName.size() + 1);
+    e.head = NULL_INDEX;
+    e.tail = NULL_INDEX;
+    e.tag = sharedPool->registerOwner();
+    return SharedList<T, NUM_NODES>(*this, freeEntry);
+}
+
+template <typename T, int NUM_NODES>
+template <typename Func>
+void SharedList<T, NUM_NODES>::update(Func f)
+{
+    std::lock_guard<SharedNodePool<T, NUM_NODES> > guard(*shared);
+    SharedListEntry &e = shared->header->lists[entry];
+    List view(*shared->sharedPool, e.tag, e.head);
+    try
+    {
+        f(view, e);
+    }
+    catch (...)
+    {
+        e.head = view.detach();
+        e.tail = NULL_INDEX;
+        throw;
+    }
+    e.head = view.detach();
+}
+
+template <typename T, int NUM_NODES>
+template <typename Func>
+void SharedList<T, NUM_NODES>::apply(Func f)
+{
+    update([&](List &list, SharedListEntry &e) {
+        e.tail = NULL_INDEX; // f may change the list in any way
+        f(list);
+    });
+}
+
+template <typename T, int NUM_NODES>
+bool SharedList<T, NUM_NODES>::insertFront(const T &value)
+{
+    bool ok = false;
+    update([&](List &list, SharedListEntry &e) {
+        if (list.getPool().freeCount() == 0)
+            return;
+        bool wasEmpty = list.isEmpty();
+        list.insertFront(value);
+        if (wasEmpty)
+            e.tail = list.getHead();
+        ok = true;
+    });
+    return ok;
+}
+
+template <typename T, int NUM_NODES>
+bool SharedList<T, NUM_NODES>::insertBack(const T &value)
+{
+    bool ok = false;
+    update([&](List &list, SharedListEntry &e) {
+        NodePool<T, NUM_NODES> &pool = list.getPool();
+        if (pool.freeCount() == 0)
+            return;
+        if (list.isEmpty())
+        {
+            list.insertFront(value);
+            e.tail = list.getHead();
+            ok = true;
+            return;
+        }
+        if (e.tail == NULL_INDEX)
+        {
+            int ptr = list.getHead();
+            while (pool.node(ptr).next != NULL_INDEX)
+                ptr = pool.node(ptr).next;
+            e.tail = ptr;
+        }
+        int idx = pool.newNode(e.tag);
+        pool.node(idx).data = value;
+        pool.node(e.tail).next = idx;
+        e.tail = idx;
+        ok = true;
+    });
+    return ok;
+}
+
+template <typename T, int NUM_NODES>
+bool SharedList<T, NUM_NODES>::popFront(T &value)
+{
+    bool ok = false;
+    update([&](List &list, SharedListEntry &e) {
+        if (list.isEmpty())
+            return;
+        value = list.getPool()[list.getHead()].data;
+        ok = list.deleteFront();
+        if (list.isEmpty())
+            e.tail = NULL_INDEX;
+    });
+    return ok;
+}
+
+template <typename T, int NUM_NODES>
+int SharedList<T, NUM_NODES>::size()
+{
+    int n = 0;
+    apply([&](List &list) { n = list.size(); });
+    return n;
+}
+
+template <typename T, int NUM_NODES>
+bool SharedList<T, NUM_NODES>::contains(const T &value)
+{
+    bool found = false;
+    apply([&](List &list) { found = list.contains(value); });
+    return found;
+}
+
+#endif // SHARED_POOL_H
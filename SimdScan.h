@@ -0,0 +1,270 @@
+/*-- SimdScan.h ------------------------------------------------------------
+
+  This header file defines order-independent scans over the slot array of
+  a NodePool. Instead of chasing next indices from a list head, the scan
+  walks the contiguous pool array and compares every payload against a
+  value, keeping only slots whose owner tag matches (see NodePool::owners).
+
+  For int, unsigned int and float payloads the comparison is vectorized
+  (8 slots per step with AVX2, 4 with SSE2), selected once at runtime from
+  the CPU features; other payload types, other CPUs and compilers use the
+  scalar loop.
+
+  Basic operations are:
+     simdScanMatches:  Call visit(slot) for each matching slot, in slot order,
+                       until visit returns false.
+     simdCountMatches: Number of matching slots.
+     simdLevelName:    Name of the kernel chosen at runtime.
+-------------------------------------------------------------------------*/
+
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include "NodePool.h"
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+enum SimdLevel
+{
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2
+};
+
+/***** simdLevel *****/
+inline SimdLevel simdLevel()
+{
+#ifdef SIMD_SCAN_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx2")   ? SIMD_AVX2
+                                   : __builtin_cpu_supports("sse2") ? SIMD_SSE2
+                                                                    : SIMD_SCALAR;
+    return level;
+#else
+    return SIMD_SCALAR;
+#endif
+}
+/*----------------------------------------------------------------------
+  Detect (once) the widest scan kernel this CPU supports.
+
+  Precondition:  None
+  Postcondition: Returns SIMD_AVX2, SIMD_SSE2 or SIMD_SCALAR.
+-----------------------------------------------------------------------*/
+
+inline const char *simdLevelName()
+{
+    switch (simdLevel())
+    {
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+/***** Payload types with a vector kernel *****/
+template <typename T>
+struct SimdScanTraits
+{
+    static const bool vectorized = false;
+    static const bool isFloat = false;
+};
+
+template <>
+struct SimdScanTraits<int>
+{
+    static const bool vectorized = true;
+    static const bool isFloat = false;
+};
+
+template <>
+struct SimdScanTraits<unsigned int>
+{
+    static const bool vectorized = true;
+    static const bool isFloat = false;
+};
+
+template <>
+struct SimdScanTraits<float>
+{
+    static const bool vectorized = true;
+    static const bool isFloat = true;
+};
+
+#ifdef SIMD_SCAN_X86
+
+/*----------------------------------------------------------------------
+  Vector kernels. base points at an array of 8-byte nodes {payload, next}
+  with a 4-byte payload; owners is the parallel owner-tag array. Both
+  kernels handle whole blocks only and return the first slot they did not
+  examine, or -1 if visit asked to stop.
+-----------------------------------------------------------------------*/
+template <bool IS_FLOAT, typename Visit>
+__attribute__((target("avx2"))) int simdScanBlocksAvx2(const char *base, const unsigned char *owners,
+                                                       int n, int bits, unsigned char tag, Visit &visit)
+{
+    const __m256i want = _mm256_set1_epi32(bits);
+    const __m256i tagv = _mm256_set1_epi32(tag);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i lo = _mm256_loadu_si256((const __m256i *)(base + i * 8));
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(base + i * 8 + 32));
+
+        // Gather the 8 payload lanes: [d0 d1 d4 d5 | d2 d3 d6 d7] -> d0..d7
+        __m256 mixed = _mm256_shuffle_ps(_mm256_castsi256_ps(lo), _mm256_castsi256_ps(hi),
+                                         _MM_SHUFFLE(2, 0, 2, 0));
+        __m256i data = _mm256_castpd_si256(
+            _mm256_permute4x64_pd(_mm256_castps_pd(mixed), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        __m256i eq;
+        if (IS_FLOAT)
+            eq = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(data),
+                                                   _mm256_castsi256_ps(want), _CMP_EQ_OQ));
+        else
+            eq = _mm256_cmpeq_epi32(data, want);
+
+        __m256i tags = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(owners + i)));
+        eq = _mm256_and_si256(eq, _mm256_cmpeq_epi32(tags, tagv));
+
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        while (mask)
+        {
+            if (!visit(i + __builtin_ctz(mask)))
+                return -1;
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+template <bool IS_FLOAT, typename Visit>
+int simdScanBlocksSse2(const char *base, const unsigned char *owners,
+                       int n, int bits, unsigned char tag, Visit &visit)
+{
+    const __m128i want = _mm_set1_epi32(bits);
+    const __m128i tagv = _mm_set1_epi32(tag);
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 lo = _mm_loadu_ps((const float *)(base + i * 8));
+        __m128 hi = _mm_loadu_ps((const float *)(base + i * 8 + 16));
+        __m128 data = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+
+        __m128i eq;
+        if (IS_FLOAT)
+            eq = _mm_castps_si128(_mm_cmpeq_ps(data, _mm_castsi128_ps(want)));
+        else
+            eq = _mm_cmpeq_epi32(_mm_castps_si128(data), want);
+
+        int packed;
+        std::memcpy(&packed, owners + i, sizeof(packed));
+        __m128i tags = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+        eq = _mm_and_si128(eq, _mm_cmpeq_epi32(tags, tagv));
+
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mask)
+        {
+            if (!visit(i + __builtin_ctz(mask)))
+                return -1;
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+#endif // SIMD_SCAN_X86
+
+/***** Vector dispatch (payload type without a kernel) *****/
+template <typename T, int NUM_NODES, typename Visit>
+int simdScanBlocks(const NodePool<T, NUM_NODES> &, const T &, unsigned char, Visit &, std::false_type)
+{
+    return 0;
+}
+
+/***** Vector dispatch (int / unsigned / float payload) *****/
+template <typename T, int NUM_NODES, typename Visit>
+int simdScanBlocks(const NodePool<T, NUM_NODES> &pool, const T &value, unsigned char tag,
+                   Visit &visit, std::true_type)
+{
+#ifdef SIMD_SCAN_X86
+    typedef typename NodePool<T, NUM_NODES>::Node Node;
+    static_assert(sizeof(Node) == 8, "vector scan expects {4-byte payload, int next} nodes");
+
+    const bool isFloat = SimdScanTraits<T>::isFloat;
+    const char *base = reinterpret_cast<const char *>(pool.nodes());
+    int bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    switch (simdLevel())
+    {
+    case SIMD_AVX2:
+        return simdScanBlocksAvx2<isFloat>(base, pool.owners(), NUM_NODES, bits, tag, visit);
+    case SIMD_SSE2:
+        return simdScanBlocksSse2<isFloat>(base, pool.owners(), NUM_NODES, bits, tag, visit);
+    default:
+        return 0;
+    }
+#else
+    (void)pool;
+    (void)value;
+    (void)tag;
+    (void)visit;
+    return 0;
+#endif
+}
+
+/***** simdScanMatches *****/
+template <typename T, int NUM_NODES, typename Visit>
+bool simdScanMatches(const NodePool<T, NUM_NODES> &pool, const T &value,
+                     unsigned char ownerTag, Visit visit)
+{
+    std::integral_constant<bool, SimdScanTraits<T>::vectorized> kernel;
+    int i = simdScanBlocks(pool, value, ownerTag, visit, kernel);
+    if (i < 0)
+        return false;
+
+    // Scalar tail (or whole array when there is no vector kernel)
+    const typename NodePool<T, NUM_NODES>::Node *nodes = pool.nodes();
+    const unsigned char *owners = pool.owners();
+    for (; i < NUM_NODES; ++i)
+    {
+        if (owners[i] == ownerTag && nodes[i].data == value && !visit(i))
+            return false;
+    }
+    return true;
+}
+/*----------------------------------------------------------------------
+  Visit every slot tagged ownerTag whose payload equals value.
+
+  Precondition:  visit is callable as bool(int slot).
+  Postcondition: Slots are visited in increasing index order; returns
+                 false if visit stopped the scan early, true otherwise.
+-----------------------------------------------------------------------*/
+
+/***** simdCountMatches *****/
+template <typename T, int NUM_NODES>
+int simdCountMatches(const NodePool<T, NUM_NODES> &pool, const T &value, unsigned char ownerTag)
+{
+    int count = 0;
+    simdScanMatches(pool, value, ownerTag, [&count](int) {
+        ++count;
+        return true;
+    });
+    return count;
+}
+/*----------------------------------------------------------------------
+  Count the slots tagged ownerTag whose payload equals value.
+
+  Precondition:  None
+  Postcondition: Returns the number of matching slots.
+-----------------------------------------------------------------------*/
+
+#endif // SIMD_SCAN_H
@@ -0,0 +1,357 @@
+/*-- Snapshot.h ------------------------------------------------------------
+
+  This header file defines a compact binary snapshot of a NodePool and the
+  heads of the lists that live in it.
+
+  File layout (native byte order):
+     SnapshotHeader        magic, version, layout checks, free head, counts
+     int32  listHeads[]    one head index per saved list
+     Node / next block     trivially-copyable T: the whole slot array in
+                           one block; otherwise the next index array
+     uint8  owners[]       used / free flag per slot
+     payload block         non-trivial T only: one length-prefixed value
+                           per used slot, in slot order
+
+  Payload encoding is chosen by SnapshotCodec<T>: a raw copy for
+  trivially-copyable T (so a pool is restored with a single read) and
+  length-prefixed bytes for std::string.
+
+  Basic operations are:
+     saveSnapshot(os, pool, lists, seq) – write pool and list heads
+     loadSnapshot(is, pool, lists)      – restore them (lists are attached)
+                                          and return seq
+     saveSnapshotFile / loadSnapshotFile – same, by file name
+
+  seq is a caller-chosen sequence number kept in the header; Journal.h
+  stores it in the log started after the snapshot so recovery can tell
+  whether the log belongs to it.
+-------------------------------------------------------------------------*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct ArenaString;
+
+/***** SnapshotCodec *****/
+template <typename T, bool TRIVIAL = std::is_trivially_copyable<T>::value>
+struct SnapshotCodec;
+
+template <typename T>
+struct SnapshotCodec<T, true>
+{
+    static const unsigned int ENCODING = 0; // raw bytes
+
+    static void encode(std::vector<char> &buf, const T &value)
+    {
+        const char *bytes = reinterpret_cast<const char *>(&value);
+        buf.insert(buf.end(), bytes, bytes + sizeof(T));
+    }
+
+    static const char *decode(const char *p, const char *end, T &value)
+    {
+        if (end - p < (long)sizeof(T))
+            throw std::runtime_error("snapshot: truncated value");
+        std::memcpy(&value, p, sizeof(T));
+        return p + sizeof(T);
+    }
+};
+
+template <>
+struct SnapshotCodec<std::string, false>
+{
+    static const unsigned int ENCODING = 1; // uint32 length + bytes
+
+    static void encode(std::vector<char> &buf, const std::string &value)
+    {
+        unsigned int length = (unsigned int)value.size();
+        const char *len = reinterpret_cast<const char *>(&length);
+        buf.insert(buf.end(), len, len + sizeof(length));
+        buf.insert(buf.end(), value.begin(), value.end());
+    }
+
+    static const char *decode(const char *p, const char *end, std::string &value)
+    {
+        unsigned int length;
+        if (end - p < (long)sizeof(length))
+            throw std::runtime_error("snapshot: truncated length");
+        std::memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if ((unsigned long)(end - p) < length)
+            throw std::runtime_error("snapshot: truncated string");
+        value.assign(p, length);
+        return p + length;
+    }
+};
+
+// ArenaString holds a pointer into its pool's arena; a raw copy would be
+// meaningless after a restart, so it has no codec (use the string text).
+template <>
+struct SnapshotCodec<ArenaString, true>;
+/*----------------------------------------------------------------------
+  encode appends one value to buf; decode reads one value from [p, end)
+  and returns the position after it (throws std::runtime_error if the
+  input is truncated). The same codec encodes journal payloads.
+-----------------------------------------------------------------------*/
+
+/***** SnapshotHeader *****/
+struct SnapshotHeader
+{
+    char magic[8];            // "NPOOLSNP"
+    unsigned int version;     // SNAPSHOT_VERSION
+    unsigned int byteOrder;   // 0x01020304 as written
+    unsigned int numNodes;    // NUM_NODES
+    unsigned int nodeSize;    // sizeof(Node)
+    unsigned int encoding;    // SnapshotCodec<T>::ENCODING
+    unsigned int listCount;   // number of saved list heads
+    int freeHead;             // head of the pool's free list
+    int used;                 // number of used nodes
+    unsigned long long sequence; // caller's snapshot sequence number
+};
+
+static const unsigned int SNAPSHOT_VERSION = 2; // 2: sequence number
+static const unsigned int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+/***** PoolSnapshot class *****/
+template <typename T, int NUM_NODES>
+class PoolSnapshot
+{
+public:
+    typedef NodePool<T, NUM_NODES> Pool;
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+    typedef SnapshotCodec<T> Codec;
+
+    static void save(std::ostream &os, const Pool &pool, const std::vector<const List *> &lists,
+                     unsigned long long sequence);
+    static unsigned long long load(std::istream &is, Pool &pool, const std::vector<List *> &lists);
+
+private:
+    static void writeBlock(std::ostream &os, const void *data, size_t bytes);
+    static void readBlock(std::istream &is, void *data, size_t bytes);
+};
+
+template <typename T, int NUM_NODES>
+void PoolSnapshot<T, NUM_NODES>::writeBlock(std::ostream &os, const void *data, size_t bytes)
+{
+    if (!os.write(static_cast<const char *>(data), (std::streamsize)bytes))
+        throw std::runtime_error("snapshot: write failed");
+}
+
+template <typename T, int NUM_NODES>
+void PoolSnapshot<T, NUM_NODES>::readBlock(std::istream &is, void *data, size_t bytes)
+{
+    if (!is.read(static_cast<char *>(data), (std::streamsize)bytes))
+        throw std::runtime_error("snapshot: unexpected end of file");
+}
+
+template <typename T, int NUM_NODES>
+void PoolSnapshot<T, NUM_NODES>::save(std::ostream &os, const Pool &pool,
+                                      const std::vector<const List *> &lists,
+                                      unsigned long long sequence)
+{
+    SnapshotHeader header = SnapshotHeader();
+    std::memcpy(header.magic, "NPOOLSNP", sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.numNodes = NUM_NODES;
+    header.nodeSize = sizeof(typename Pool::Node);
+    header.encoding = Codec::ENCODING;
+    header.listCount = (unsigned int)lists.size();
+    header.freeHead = pool.freeHead;
+    header.used = pool.used;
+    header.sequence = sequence;
+    writeBlock(os, &header, sizeof(header));
+
+    std::vector<int> heads(lists.size());
+    for (size_t i = 0; i < lists.size(); ++i)
+        heads[i] = lists[i]->getHead();
+    if (!heads.empty())
+        writeBlock(os, heads.data(), heads.size() * sizeof(int));
+
+    if (std::is_trivially_copyable<T>::value)
+    {
+        writeBlock(os, pool.pool, sizeof(pool.pool));
+        writeBlock(os, pool.owner, sizeof(pool.owner));
+        return;
+    }
+
+    std::vector<int> links(NUM_NODES);
+    std::vector<char> payload;
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        links[i] = pool.pool[i].next;
+        if (pool.owner[i] != FREE_OWNER)
+            Codec::encode(payload, pool.pool[i].data);
+    }
+    unsigned long long payloadBytes = payload.size();
+    writeBlock(os, links.data(), links.size() * sizeof(int));
+    writeBlock(os, pool.owner, sizeof(pool.owner));
+    writeBlock(os, &payloadBytes, sizeof(payloadBytes));
+    writeBlock(os, payload.data(), payload.size());
+}
+
+template <typename T, int NUM_NODES>
+unsigned long long PoolSnapshot<T, NUM_NODES>::load(std::istream &is, Pool &pool,
+                                                    const std::vector<List *> &lists)
+{
+    SnapshotHeader header;
+    readBlock(is, &header, sizeof(header));
+    if (std::memcmp(header.magic, "NPOOLSNP", sizeof(header.magic)) != 0)
+        throw std::runtime_error("snapshot: not a NodePool snapshot");
+    if (header.version != SNAPSHOT_VERSION || header.byteOrder != SNAPSHOT_BYTE_ORDER)
+        throw std::runtime_error("snapshot: unsupported version or byte order");
+    if (header.numNodes != (unsigned int)NUM_NODES || header.nodeSize != sizeof(typename Pool::Node) ||
+        header.encoding != Codec::ENCODING)
+        throw std::runtime_error("snapshot: pool layout does not match");
+    if (header.listCount != lists.size())
+        throw std::runtime_error("snapshot: list count does not match");
+
+    std::vector<int> heads(lists.size());
+    if (!heads.empty())
+        readBlock(is, heads.data(), heads.size() * sizeof(int));
+
+    // Decode into a staging pool so a bad file leaves pool and lists as
+    // they were; the pool only changes once the file has been checked
+    std::unique_ptr<Pool> staged(new Pool);
+    if (std::is_trivially_copyable<T>::value)
+    {
+        readBlock(is, staged->pool, sizeof(staged->pool));
+        readBlock(is, staged->owner, sizeof(staged->owner));
+    }
+    else
+    {
+        std::vector<int> links(NUM_NODES);
+        readBlock(is, links.data(), links.size() * sizeof(int));
+        readBlock(is, staged->owner, sizeof(staged->owner));
+        unsigned long long payloadBytes;
+        readBlock(is, &payloadBytes, sizeof(payloadBytes));
+        std::vector<char> payload(payloadBytes);
+        readBlock(is, payload.data(), payload.size());
+
+        const char *p = payload.data();
+        const char *end = p + payload.size();
+        for (int i = 0; i < NUM_NODES; ++i)
+        {
+            staged->pool[i].next = links[i];
+            if (staged->owner[i] != FREE_OWNER)
+                p = Codec::decode(p, end, staged->pool[i].data);
+        }
+    }
+    staged->freeHead = header.freeHead;
+    staged->used = header.used;
+
+    // A corrupt file must not reach attach, which would follow a cyclic
+    // chain forever or claim nodes that are free or on another list
+    const char *problem = staged->checkChains(heads.data(), (int)heads.size());
+    if (problem)
+        throw std::runtime_error(std::string("snapshot: ") + problem);
+
+    // Commit: the old contents are replaced wholesale. Owner tags are per
+    // process, so used slots are marked shared and the lists re-tag them.
+    // Every slot has new contents, so handles taken before the load die.
+    for (size_t i = 0; i < lists.size(); ++i)
+        lists[i]->detach();
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        std::swap(pool.pool[i], staged->pool[i]);
+        pool.owner[i] = staged->owner[i] != FREE_OWNER ? SHARED_OWNER : FREE_OWNER;
+        ++pool.generation[i];
+    }
+    pool.freeHead = staged->freeHead;
+    pool.used = staged->used;
+    for (size_t i = 0; i < lists.size(); ++i)
+        lists[i]->attach(heads[i]);
+    return header.sequence;
+}
+
+/***** saveSnapshot *****/
+template <typename T, int NUM_NODES>
+void saveSnapshot(std::ostream &os, const NodePool<T, NUM_NODES> &pool,
+                  const std::vector<const ArrayLinkedList<T, NUM_NODES> *> &lists,
+                  unsigned long long sequence = 0)
+{
+    PoolSnapshot<T, NUM_NODES>::save(os, pool, lists, sequence);
+}
+
+template <typename T, int NUM_NODES>
+void saveSnapshot(std::ostream &os, const NodePool<T, NUM_NODES> &pool,
+                  const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists,
+                  unsigned long long sequence = 0)
+{
+    std::vector<const ArrayLinkedList<T, NUM_NODES> *> constLists(lists.begin(), lists.end());
+    PoolSnapshot<T, NUM_NODES>::save(os, pool, constLists, sequence);
+}
+/*----------------------------------------------------------------------
+  Write a snapshot of pool and the heads of lists (in the given order).
+  lists may hold const or non-const list pointers, so the vector given to
+  loadSnapshot can be saved as is.
+
+  Precondition:  os is opened in binary mode; every list uses pool and
+                 together they hold all of its used nodes (loading checks
+                 this).
+  Postcondition: The snapshot is written, tagged with sequence.
+  Throws: std::runtime_error if the stream fails.
+-----------------------------------------------------------------------*/
+
+/***** loadSnapshot *****/
+template <typename T, int NUM_NODES>
+unsigned long long loadSnapshot(std::istream &is, NodePool<T, NUM_NODES> &pool,
+                                const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists)
+{
+    return PoolSnapshot<T, NUM_NODES>::load(is, pool, lists);
+}
+/*----------------------------------------------------------------------
+  Restore pool and list contents from a snapshot.
+
+  Precondition:  is is opened in binary mode; lists use pool, in the same
+                 order as when saved. Other lists of pool are empty.
+  Postcondition: pool holds the saved nodes and each list is attached to
+                 its saved head. Returns the snapshot's sequence number.
+  Throws: std::runtime_error on a bad file, a layout mismatch (type,
+          pool size, format version) or inconsistent links (out-of-range
+          index, cycle, node shared by two lists, list node marked free,
+          counts that do not add up); pool and lists are then unchanged.
+-----------------------------------------------------------------------*/
+
+/***** saveSnapshotFile / loadSnapshotFile *****/
+template <typename T, int NUM_NODES>
+void saveSnapshotFile(const std::string &path, const NodePool<T, NUM_NODES> &pool,
+                      const std::vector<const ArrayLinkedList<T, NUM_NODES> *> &lists,
+                      unsigned long long sequence = 0)
+{
+    std::ofstream os(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!os)
+        throw std::runtime_error("snapshot: cannot open " + path);
+    saveSnapshot(os, pool, lists, sequence);
+}
+
+template <typename T, int NUM_NODES>
+void saveSnapshotFile(const std::string &path, const NodePool<T, NUM_NODES> &pool,
+                      const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists,
+                      unsigned long long sequence = 0)
+{
+    std::vector<const ArrayLinkedList<T, NUM_NODES> *> constLists(lists.begin(), lists.end());
+    saveSnapshotFile(path, pool, constLists, sequence);
+}
+
+template <typename T, int NUM_NODES>
+unsigned long long loadSnapshotFile(const std::string &path, NodePool<T, NUM_NODES> &pool,
+                                    const std::vector<ArrayLinkedList<T, NUM_NODES> *> &lists)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    if (!is)
+        throw std::runtime_error("snapshot: cannot open " + path);
+    return loadSnapshot(is, pool, lists);
+}
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,82 @@
+/*-- StaticList.h ----------------------------------------------------------
+
+  This header file defines compile-time built lookup lists (C++20).
+
+  From C++20 on NodePool and the ArrayLinkedList operations are constexpr
+  for literal T (see POOL_CONSTEXPR in NodePool.h), so a filled pool can
+  be the result of a constant expression:
+
+     constexpr StaticList<int, 8> primes = makeStaticList<int, 8>(
+         [](ArrayLinkedList<int, 8> &l) { for (int p : {2, 3, 5, 7}) l.insertBack(p); });
+
+  A constexpr table lives in read-only data; a constinit one is built the
+  same way but stays writable. Neither costs anything at startup.
+
+  Basic operations are:
+     makeStaticList<T, N>(build)  – run build on a list over a fresh pool
+                                    and keep the resulting pool and head
+     read(f)                      – call f with a const ArrayLinkedList
+                                    view of the table, return its result
+
+  A constinit table can also be wrapped in a writable view
+  (ArrayLinkedList(table.pool, SHARED_OWNER, table.head)); detach() the
+  view before it goes out of scope to keep the nodes.
+-------------------------------------------------------------------------*/
+
+#ifndef STATIC_LIST_H
+#define STATIC_LIST_H
+
+#include "NodePool.h"
+#include "List.h"
+
+/***** StaticList *****/
+template <typename T, int NUM_NODES>
+struct StaticList
+{
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+
+    NodePool<T, NUM_NODES> pool;
+    int head;
+
+    template <typename F>
+    POOL_CONSTEXPR decltype(auto) read(F f) const
+    {
+        // Only const operations run on the view, so the table is never
+        // written even though the view needs a non-const pool reference
+        List view(const_cast<NodePool<T, NUM_NODES> &>(pool), SHARED_OWNER, head);
+        struct Release
+        {
+            List &list;
+            POOL_CONSTEXPR ~Release() { list.detach(); }
+        } release{view};
+        return f(static_cast<const List &>(view));
+    }
+    /*----------------------------------------------------------------------
+      Precondition:  f takes a const List & and does not keep it.
+      Postcondition: Returns f's result; the table is unchanged.
+    -----------------------------------------------------------------------*/
+};
+
+/***** makeStaticList *****/
+template <typename T, int NUM_NODES, typename Build>
+POOL_CONSTEXPR StaticList<T, NUM_NODES> makeStaticList(Build build)
+{
+    StaticList<T, NUM_NODES> table{NodePool<T, NUM_NODES>(), NULL_INDEX};
+    {
+        ArrayLinkedList<T, NUM_NODES> list(table.pool);
+        build(list);
+        table.head = list.detach();
+    } // releases the list's owner tag
+    for (int ptr = table.head; ptr != NULL_INDEX; ptr = table.pool.node(ptr).next)
+        table.pool.setOwner(ptr, SHARED_OWNER);
+    return table;
+}
+/*----------------------------------------------------------------------
+  Precondition:  build(list) fits in NUM_NODES nodes (a full pool would
+                 prompt, which is not a constant expression). Large
+                 tables may need a higher -fconstexpr-ops-limit.
+  Postcondition: Returns the pool holding the built chain, its nodes
+                 tagged SHARED_OWNER and no owner tag reserved.
+-----------------------------------------------------------------------*/
+
+#endif // STATIC_LIST_H
@@ -0,0 +1,227 @@
+/*-- StringArena.h ---------------------------------------------------------
+
+  This header file defines a string payload mode for ArrayLinkedList.
+  Instead of one heap allocation per std::string, the characters of every
+  value live in one growable arena owned by the pool, and each node stores
+  a compact ArenaString (arena, offset, length).
+
+     StringArena:       Append-only character buffer.
+     ArenaString:       16-byte handle to characters in an arena; compares
+                        by content like std::string.
+     StringNodePool<N>: NodePool<ArenaString, N> that owns the arena.
+
+  Typical use:
+     StringNodePool<1000> pool;
+     ArrayLinkedList<ArenaString, 1000> list(pool);
+     list.insertSorted(pool.intern("apple"));
+
+  Basic StringNodePool operations are:
+     intern:      Copy characters into the arena, return their ArenaString.
+     arenaBytes:  Bytes currently held by the arena.
+     compact:     Rebuild the arena with only the strings of used nodes.
+     reset:       Free every node and empty the arena.
+-------------------------------------------------------------------------*/
+
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include "NodePool.h"
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/***** StringArena class *****/
+class StringArena
+{
+public:
+    unsigned int append(const char *chars, size_t length);
+    /*----------------------------------------------------------------------
+      Copy length characters to the end of the arena.
+
+      Precondition:  The arena stays below 4 GiB.
+      Postcondition: Returns the offset of the copy.
+      Throws: std::length_error if the arena would exceed 4 GiB.
+    -----------------------------------------------------------------------*/
+
+    const char *data() const { return chars.data(); }
+    size_t size() const { return chars.size(); }
+    size_t capacity() const { return chars.capacity(); }
+    void clear() { chars.clear(); }
+    void reserve(size_t bytes) { chars.reserve(bytes); }
+    void swap(StringArena &other) { chars.swap(other.chars); }
+
+private:
+    std::vector<char> chars;
+};
+
+inline unsigned int StringArena::append(const char *text, size_t length)
+{
+    size_t offset = chars.size();
+    if (offset + length > 0xFFFFFFFFu)
+        throw std::length_error("StringArena::append");
+    chars.insert(chars.end(), text, text + length);
+    return (unsigned int)offset;
+}
+
+/***** ArenaString class *****/
+struct ArenaString
+{
+    const StringArena *arena;
+    unsigned int offset;
+    unsigned int length;
+
+    ArenaString() : arena(0), offset(0), length(0) {}
+    ArenaString(const StringArena *a, unsigned int off, unsigned int len)
+        : arena(a), offset(off), length(len) {}
+
+    std::string_view view() const
+    {
+        return length == 0 ? std::string_view() : std::string_view(arena->data() + offset, length);
+    }
+    std::string str() const { return std::string(view()); }
+};
+/*----------------------------------------------------------------------
+  The view stays valid until the arena grows, is compacted or reset; the
+  (offset, length) handle itself stays valid until compact/reset.
+-----------------------------------------------------------------------*/
+
+inline bool operator==(const ArenaString &a, const ArenaString &b) { return a.view() == b.view(); }
+inline bool operator!=(const ArenaString &a, const ArenaString &b) { return a.view() != b.view(); }
+inline bool operator<(const ArenaString &a, const ArenaString &b) { return a.view() < b.view(); }
+inline bool operator>(const ArenaString &a, const ArenaString &b) { return a.view() > b.view(); }
+inline bool operator<=(const ArenaString &a, const ArenaString &b) { return a.view() <= b.view(); }
+inline bool operator>=(const ArenaString &a, const ArenaString &b) { return a.view() >= b.view(); }
+
+// Heterogeneous comparisons let lists of ArenaString be searched with a
+// std::string_view (or anything converting to one) without interning it.
+inline bool operator==(const ArenaString &a, std::string_view b) { return a.view() == b; }
+inline bool operator==(std::string_view a, const ArenaString &b) { return a == b.view(); }
+inline bool operator!=(const ArenaString &a, std::string_view b) { return a.view() != b; }
+inline bool operator!=(std::string_view a, const ArenaString &b) { return a != b.view(); }
+inline bool operator<(const ArenaString &a, std::string_view b) { return a.view() < b; }
+inline bool operator<(std::string_view a, const ArenaString &b) { return a < b.view(); }
+
+inline std::ostream &operator<<(std::ostream &os, const ArenaString &s)
+{
+    return os << s.view();
+}
+
+/***** readValue overload *****/
+inline std::istream &readValue(std::istream &is, ArenaString &value)
+{
+    // Values typed at the full-pool prompt are only compared, never stored,
+    // so they live in a scratch arena that is reused for every read.
+    static StringArena scratch;
+    std::string line;
+    std::getline(is, line);
+    scratch.clear();
+    value = ArenaString(&scratch, scratch.append(line.data(), line.size()), (unsigned int)line.size());
+    return is;
+}
+
+/***** StringNodePool class *****/
+template <int NUM_NODES>
+class StringNodePool : public NodePool<ArenaString, NUM_NODES>
+{
+public:
+    StringNodePool() {}
+
+    ArenaString intern(std::string_view text);
+    /*----------------------------------------------------------------------
+      Copy text into the pool's arena.
+
+      Precondition:  None
+      Postcondition: Returns an ArenaString for the copy; no per-string
+                     heap allocation (the arena grows geometrically).
+    -----------------------------------------------------------------------*/
+
+    size_t arenaBytes() const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns the arena's allocated capacity in bytes.
+    -----------------------------------------------------------------------*/
+
+    const StringArena &getArena() const;
+
+    void compact();
+    /*----------------------------------------------------------------------
+      Drop the characters of removed and replaced strings.
+
+      Precondition:  ArenaStrings held outside the pool are not used again.
+      Postcondition: The arena holds only the strings of used nodes (in
+                     slot order); free nodes hold empty strings.
+    -----------------------------------------------------------------------*/
+
+    void reset();
+    /*----------------------------------------------------------------------
+      Precondition:  No list holds nodes of this pool any more.
+      Postcondition: Every node is free and the arena is empty with its
+                     storage released.
+    -----------------------------------------------------------------------*/
+
+private:
+    StringNodePool(const StringNodePool &);
+    StringNodePool &operator=(const StringNodePool &);
+
+    StringArena arena; // characters of every interned string
+
+}; //--- end of StringNodePool class
+
+template <int NUM_NODES>
+ArenaString StringNodePool<NUM_NODES>::intern(std::string_view text)
+{
+    unsigned int offset = arena.append(text.data(), text.size());
+    return ArenaString(&arena, offset, (unsigned int)text.size());
+}
+
+template <int NUM_NODES>
+size_t StringNodePool<NUM_NODES>::arenaBytes() const
+{
+    return arena.capacity();
+}
+
+template <int NUM_NODES>
+const StringArena &StringNodePool<NUM_NODES>::getArena() const
+{
+    return arena;
+}
+
+template <int NUM_NODES>
+void StringNodePool<NUM_NODES>::compact()
+{
+    size_t live = 0;
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        if (!this->isNodeFree(i))
+            live += (*this)[i].data.length;
+    }
+
+    StringArena fresh;
+    fresh.reserve(live);
+    for (int i = 0; i < NUM_NODES; ++i)
+    {
+        ArenaString &s = (*this)[i].data;
+        if (this->isNodeFree(i) || s.length == 0)
+        {
+            s = ArenaString();
+            continue;
+        }
+        s.offset = fresh.append(s.arena->data() + s.offset, s.length);
+        s.arena = &arena;
+    }
+    arena.swap(fresh);
+}
+
+template <int NUM_NODES>
+void StringNodePool<NUM_NODES>::reset()
+{
+    NodePool<ArenaString, NUM_NODES>::reset();
+    for (int i = 0; i < NUM_NODES; ++i)
+        (*this)[i].data = ArenaString();
+    StringArena().swap(arena); // give the characters back, as compact() does
+}
+
+#endif // STRING_ARENA_H
@@ -0,0 +1,170 @@
+/*-- ThreadPool.h ----------------------------------------------------------
+
+  This header file defines the class ThreadPool, a fixed set of worker
+  threads that run indexed tasks for bulk list algorithms.
+
+  Basic operations are:
+     Constructor:   Start the workers (default: one per hardware thread).
+     Destructor:    Stop and join the workers.
+     size:          Number of threads taking part in a parallelFor
+                    (workers plus the calling thread).
+     parallelFor:   Run f(0) .. f(tasks - 1) and wait for all of them.
+     shared:        Process-wide pool used by ParallelList.h.
+-------------------------------------------------------------------------*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    /***** Class constructor *****/
+    explicit ThreadPool(int threads = 0);
+    /*----------------------------------------------------------------------
+      Start a pool of worker threads.
+
+      Precondition:  threads >= 0 (0 means hardware_concurrency()).
+      Postcondition: threads - 1 workers are waiting; the thread calling
+                     parallelFor is the last participant.
+    -----------------------------------------------------------------------*/
+
+    /***** Class destructor *****/
+    ~ThreadPool();
+
+    /***** size operation *****/
+    int size() const;
+    /*----------------------------------------------------------------------
+      Precondition:  None
+      Postcondition: Returns the number of threads that share a job.
+    -----------------------------------------------------------------------*/
+
+    /***** parallelFor operation *****/
+    void parallelFor(int tasks, const std::function<void(int)> &task);
+    /*----------------------------------------------------------------------
+      Run task(i) for every i in [0, tasks) on the pool.
+
+      Precondition:  task must not call parallelFor on the same pool.
+      Postcondition: Every task has finished when the call returns.
+                     Concurrent callers are served one job at a time.
+    -----------------------------------------------------------------------*/
+
+    /***** shared pool *****/
+    static ThreadPool &shared();
+
+private:
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    void workerLoop();
+    void drainTasks();
+
+    /******** Data Members ********/
+    std::vector<std::thread> workers;
+    std::mutex jobLock;                 // one job at a time
+    std::mutex stateLock;               // guards the fields below
+    std::condition_variable wake;       // a new job or shutdown
+    std::condition_variable finished;   // last worker left the job
+    const std::function<void(int)> *job;
+    int jobTasks;
+    std::atomic<int> nextTask;
+    int busyWorkers;
+    unsigned long generation;
+    bool stopping;
+
+}; //--- end of ThreadPool class
+
+/***** Implementation Section *****/
+
+inline ThreadPool::ThreadPool(int threads)
+    : job(0), jobTasks(0), nextTask(0), busyWorkers(0), generation(0), stopping(false)
+{
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+}
+
+inline int ThreadPool::size() const
+{
+    return (int)workers.size() + 1;
+}
+
+inline ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline void ThreadPool::drainTasks()
+{
+    for (int t = nextTask.fetch_add(1); t < jobTasks; t = nextTask.fetch_add(1))
+        (*job)(t);
+}
+
+inline void ThreadPool::parallelFor(int tasks, const std::function<void(int)> &task)
+{
+    if (tasks <= 0)
+        return;
+
+    std::lock_guard<std::mutex> serial(jobLock);
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        job = &task;
+        jobTasks = tasks;
+        nextTask.store(0);
+        busyWorkers = (int)workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    drainTasks();
+
+    std::unique_lock<std::mutex> guard(stateLock);
+    while (busyWorkers > 0)
+        finished.wait(guard);
+    job = 0;
+}
+
+inline void ThreadPool::workerLoop()
+{
+    unsigned long seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            while (!stopping && generation == seen)
+                wake.wait(guard);
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        drainTasks();
+
+        std::lock_guard<std::mutex> guard(stateLock);
+        if (--busyWorkers == 0)
+            finished.notify_one();
+    }
+}
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,380 @@
+/*-- Workload.h ------------------------------------------------------------
+
+  This header file defines the operation set of the main.cpp menu as data,
+  so the same operations can be typed interactively, read from a script,
+  recorded to a trace and replayed at full speed.
+
+  Script / trace format: one operation per line,
+     <op> [<arg>]...
+  where <op> is a menu number (1-24) or a name from the table below and
+  arguments are separated by tabs (recorded traces) or, in hand-written
+  lines without tabs, by blanks. The last argument takes the rest of the
+  line. Blank lines and lines starting with '#' are skipped.
+
+     1 front v          9 remove v             17 display
+     2 back v          10 remove_slot pos      18 find v
+     3 after key v     11 remove_duplicates    19 reverse
+     4 before key v    12 remove_all v         20 size
+     5 sorted v        13 remove_after key     21 clear
+     6 sorted_desc v   14 remove_before key    22 append2 v
+     7 at_position p v 15 sort_asc             23 concat
+     8 at_slot slot v  16 sort_desc            24 slots
+
+  Basic operations are:
+     parseWorkloadLine / formatWorkloadLine – script text <-> WorkloadOp
+     applyWorkloadOp    – run one operation on the menu's pool and lists
+     WorkloadStats      – per-operation count and latency for replays
+-------------------------------------------------------------------------*/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "NodePool.h"
+#include "List.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+static const int WORKLOAD_OPS = 24; // menu options 1..24
+
+enum WorkloadArgs { ARGS_NONE, ARGS_VALUE, ARGS_KEY, ARGS_KEY_VALUE, ARGS_POS, ARGS_POS_VALUE };
+
+/***** WorkloadOp *****/
+struct WorkloadOp
+{
+    int code;           // menu number, 1..WORKLOAD_OPS
+    std::string key;    // ARGS_KEY, ARGS_KEY_VALUE
+    std::string value;  // ARGS_VALUE, ARGS_KEY_VALUE, ARGS_POS_VALUE
+    int pos;            // ARGS_POS, ARGS_POS_VALUE
+
+    WorkloadOp() : code(0), pos(0) {}
+};
+
+/***** operation table *****/
+struct WorkloadOpInfo
+{
+    const char *name;
+    WorkloadArgs args;
+};
+
+inline const WorkloadOpInfo &workloadOpInfo(int code)
+{
+    static const WorkloadOpInfo table[WORKLOAD_OPS + 1] = {
+        {"", ARGS_NONE},
+        {"front", ARGS_VALUE},        {"back", ARGS_VALUE},
+        {"after", ARGS_KEY_VALUE},    {"before", ARGS_KEY_VALUE},
+        {"sorted", ARGS_VALUE},       {"sorted_desc", ARGS_VALUE},
+        {"at_position", ARGS_POS_VALUE}, {"at_slot", ARGS_POS_VALUE},
+        {"remove", ARGS_VALUE},       {"remove_slot", ARGS_POS},
+        {"remove_duplicates", ARGS_NONE}, {"remove_all", ARGS_VALUE},
+        {"remove_after", ARGS_KEY},   {"remove_before", ARGS_KEY},
+        {"sort_asc", ARGS_NONE},      {"sort_desc", ARGS_NONE},
+        {"display", ARGS_NONE},       {"find", ARGS_VALUE},
+        {"reverse", ARGS_NONE},       {"size", ARGS_NONE},
+        {"clear", ARGS_NONE},         {"append2", ARGS_VALUE},
+        {"concat", ARGS_NONE},        {"slots", ARGS_NONE}};
+    if (code < 1 || code > WORKLOAD_OPS)
+        throw std::out_of_range("workloadOpInfo: unknown operation");
+    return table[code];
+}
+
+inline int workloadOpCode(const std::string &word)
+{
+    char *end;
+    long number = std::strtol(word.c_str(), &end, 10);
+    if (!word.empty() && *end == '\0')
+        return (number >= 1 && number <= WORKLOAD_OPS) ? (int)number : -1;
+    for (int code = 1; code <= WORKLOAD_OPS; ++code)
+    {
+        if (word == workloadOpInfo(code).name)
+            return code;
+    }
+    return -1;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns the menu number for a number or name, or -1.
+-----------------------------------------------------------------------*/
+
+/***** parseWorkloadLine *****/
+inline bool parseWorkloadLine(const std::string &line, WorkloadOp &op)
+{
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '#')
+        return false;
+    std::string text = line.substr(start);
+    if (!text.empty() && text[text.size() - 1] == '\r')
+        text.erase(text.size() - 1);
+
+    // Split into at most three fields; the last keeps the rest of the line
+    const char *separators = text.find('\t') != std::string::npos ? "\t" : " \t";
+    std::string fields[3];
+    int count = 0;
+    size_t p = 0;
+    while (count < 3 && p <= text.size())
+    {
+        size_t stop = text.find_first_of(separators, p);
+        if (count == 2 || stop == std::string::npos)
+        {
+            fields[count++] = text.substr(p);
+            break;
+        }
+        fields[count++] = text.substr(p, stop - p);
+        p = stop + 1;
+    }
+
+    op = WorkloadOp();
+    op.code = workloadOpCode(fields[0]);
+    if (op.code < 0)
+        throw std::invalid_argument("unknown operation '" + fields[0] + "'");
+
+    WorkloadArgs args = workloadOpInfo(op.code).args;
+    int needed = args == ARGS_NONE ? 0 : (args == ARGS_KEY_VALUE || args == ARGS_POS_VALUE) ? 2 : 1;
+    if (count - 1 < needed)
+        throw std::invalid_argument("missing argument for '" + fields[0] + "'");
+    if (needed == 1)
+        fields[1] = text.substr(fields[0].size() + 1);
+
+    if (args == ARGS_POS || args == ARGS_POS_VALUE)
+    {
+        char *end;
+        op.pos = (int)std::strtol(fields[1].c_str(), &end, 10);
+        if (fields[1].empty() || *end != '\0')
+            throw std::invalid_argument("bad position '" + fields[1] + "'");
+    }
+    if (args == ARGS_KEY || args == ARGS_KEY_VALUE)
+        op.key = fields[1];
+    if (args == ARGS_VALUE)
+        op.value = fields[1];
+    if (args == ARGS_KEY_VALUE || args == ARGS_POS_VALUE)
+        op.value = fields[2];
+    return true;
+}
+/*----------------------------------------------------------------------
+  Precondition:  None
+  Postcondition: Returns false for a blank or comment line; otherwise
+                 fills op and returns true.
+  Throws: std::invalid_argument for an unknown operation, a missing
+          argument or a bad position.
+-----------------------------------------------------------------------*/
+
+/***** formatWorkloadLine *****/
+inline std::string formatWorkloadLine(const WorkloadOp &op)
+{
+    const WorkloadOpInfo &info = workloadOpInfo(op.code);
+    std::ostringstream os;
+    os << info.name;
+    if (info.args == ARGS_POS || info.args == ARGS_POS_VALUE)
+        os << '\t' << op.pos;
+    if (info.args == ARGS_KEY || info.args == ARGS_KEY_VALUE)
+        os << '\t' << op.key;
+    if (info.args == ARGS_VALUE || info.args == ARGS_KEY_VALUE || info.args == ARGS_POS_VALUE)
+        os << '\t' << op.value;
+    return os.str();
+}
+/*----------------------------------------------------------------------
+  Precondition:  op.code is a valid operation; values contain no newline.
+  Postcondition: Returns a tab-separated line parseWorkloadLine accepts.
+-----------------------------------------------------------------------*/
+
+/***** applyWorkloadOp *****/
+template <int N>
+bool applyWorkloadOp(NodePool<std::string, N> &pool, ArrayLinkedList<std::string, N> &list,
+                     ArrayLinkedList<std::string, N> &list2, const WorkloadOp &op,
+                     std::ostream &out, bool batch)
+{
+    // In batch mode a full pool refuses inserts instead of prompting
+    bool allocates = (op.code >= 1 && op.code <= 8) || op.code == 22;
+    int freeNeeded = op.code == 23 ? list2.size() : (allocates ? 1 : 0);
+    if (batch && freeNeeded > 0 && pool.freeCount() < freeNeeded)
+    {
+        out << "Pool is full: " << workloadOpInfo(op.code).name << " refused" << std::endl;
+        return false;
+    }
+
+    bool result = true;
+    int pos;
+    switch (op.code)
+    {
+    case 1:
+        list.insertFront(op.value);
+        break;
+    case 2:
+        list.insertBack(op.value);
+        break;
+    case 3:
+        result = static_cast<bool>(list.insertAfter(op.key, op.value));
+        out << (result ? "Inserted" : "Key not found") << std::endl;
+        break;
+    case 4:
+        result = static_cast<bool>(list.insertBefore(op.key, op.value));
+        out << (result ? "Inserted" : "Key not found") << std::endl;
+        break;
+    case 5:
+        list.insertSorted(op.value);
+        out << "List after insertion: " << list;
+        break;
+    case 6:
+        list.insertSortedDescending(op.value);
+        out << "List after insertion: " << list;
+        break;
+    case 7:
+        result = static_cast<bool>(list.insertAtPosition(op.pos, op.value));
+        out << (result ? "Inserted" : "Invalid position") << std::endl;
+        break;
+    case 8:
+        result = static_cast<bool>(list.insertAt(op.pos, op.value));
+        out << (result ? "Inserted" : "Invalid position") << std::endl;
+        break;
+    case 9:
+        result = list.removeValue(op.value);
+        out << (result ? "Removed" : "Value not found") << std::endl;
+        break;
+    case 10:
+        result = list.removeSlot(op.pos);
+        out << (result ? "Removed" : "Invalid position") << std::endl;
+        break;
+    case 11:
+        list.removeDuplicates();
+        out << "Duplicates removed: " << list;
+        break;
+    case 12:
+        result = list.removeAllOccurrences(op.value);
+        out << (result ? "Removed all occurrences" : "Value not found") << std::endl;
+        break;
+    case 13:
+        result = list.removeAfter(op.key);
+        out << (result ? "Removed" : "Deletion failed.") << std::endl;
+        break;
+    case 14:
+        result = list.removeBefore(op.key);
+        out << (result ? "Removed" : "Deletion failed.") << std::endl;
+        break;
+    case 15:
+        list.sortAscending();
+        out << "List in ascending order: " << list << std::endl;
+        break;
+    case 16:
+        list.sortDescending();
+        out << "List in descending order: " << list << std::endl;
+        break;
+    case 17:
+        out << list;
+        break;
+    case 18:
+        pos = list.find(op.value);
+        result = pos >= 0;
+        if (result)
+            out << "Found at position " << pos << std::endl;
+        else
+            out << "Not found" << std::endl;
+        break;
+    case 19:
+        list.reverse();
+        out << "List reversed" << std::endl;
+        break;
+    case 20:
+        out << "Size: " << list.size() << std::endl;
+        break;
+    case 21:
+        list.clear();
+        out << "List cleared" << std::endl;
+        break;
+    case 22:
+        list2.insertBack(op.value);
+        out << "Second list now: " << list2;
+        break;
+    case 23:
+        list += list2;
+        out << "After concatenation: " << list;
+        break;
+    case 24:
+        if (pool.freeCount() == 0)
+        {
+            out << "No free slots available. \n"
+                << std::endl
+                << "Used slots: ";
+            pool.displayUsed(out);
+        }
+        else if (pool.usedCount() == 0)
+        {
+            out << "No used slots available. \n"
+                << std::endl
+                << "Free slots: ";
+            pool.displayFree(out);
+        }
+        else
+        {
+            out << "Free slots: \n";
+            pool.displayFree(out);
+            out << std::endl
+                << "Used slots: ";
+            pool.displayUsed(out);
+        }
+        if (batch)
+            out << std::endl; // the menu prints its banner next instead
+        break;
+    default:
+        throw std::out_of_range("applyWorkloadOp: unknown operation");
+    }
+    return result;
+}
+/*----------------------------------------------------------------------
+  Precondition:  op.code is 1..WORKLOAD_OPS.
+  Postcondition: The operation ran and its result line went to out;
+                 returns false if it reported failure (or was refused).
+-----------------------------------------------------------------------*/
+
+/***** WorkloadStats class *****/
+class WorkloadStats
+{
+public:
+    WorkloadStats() : totalOps(0), totalNs(0)
+    {
+        for (int code = 0; code <= WORKLOAD_OPS; ++code)
+        {
+            count[code] = 0;
+            sumNs[code] = 0;
+            maxNs[code] = 0;
+        }
+    }
+
+    void add(int code, long long ns)
+    {
+        ++count[code];
+        sumNs[code] += ns;
+        if (ns > maxNs[code])
+            maxNs[code] = ns;
+        ++totalOps;
+        totalNs += ns;
+    }
+
+    void report(std::ostream &os, double wallSeconds) const
+    {
+        os << "ops," << totalOps << "\nseconds," << wallSeconds << "\nops_per_sec,"
+           << (wallSeconds > 0 ? totalOps / wallSeconds : 0) << "\n";
+        os << "op,count,mean_ns,max_ns\n";
+        for (int code = 1; code <= WORKLOAD_OPS; ++code)
+        {
+            if (count[code] == 0)
+                continue;
+            os << workloadOpInfo(code).name << "," << count[code] << ","
+               << sumNs[code] / count[code] << "," << maxNs[code] << "\n";
+        }
+    }
+
+private:
+    long long count[WORKLOAD_OPS + 1];
+    long long sumNs[WORKLOAD_OPS + 1];
+    long long maxNs[WORKLOAD_OPS + 1];
+    long long totalOps;
+    long long totalNs;
+};
+/*----------------------------------------------------------------------
+  add(code, ns) records one timed operation; report writes throughput
+  and a CSV table of per-operation count, mean and max latency.
+-----------------------------------------------------------------------*/
+
+#endif // WORKLOAD_H
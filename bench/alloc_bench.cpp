@@ -0,0 +1,194 @@
+/*-- alloc_bench.cpp -------------------------------------------------------
+
+  Allocator microbenchmark for NodePool.
+
+  Each round allocates `live` nodes and then frees them in one of three
+  orders:
+     lifo     reverse allocation order (stack-like use)
+     fifo     allocation order (queue-like use)
+     random   shuffled order (fragments the free list)
+  against:
+     NodePool            newNode / deleteNode
+     NodePool_acquire    acquire(i) of slots 0..live-1 / deleteNode; acquire
+                         searches the free list, so only live <= 1024
+     new_delete          operator new / delete of one node
+     pmr_pool            std::pmr::unsynchronized_pool_resource
+     pmr_monotonic       std::pmr::monotonic_buffer_resource (frees are
+                         no-ops; memory is released once per round)
+
+  Cache misses (PERF_COUNT_HW_CACHE_MISSES) are reported where
+  perf_event_open is permitted, otherwise -1.
+
+  Usage:
+    alloc_bench [opsPerCase]
+
+  Output: CSV lines "impl,pattern,live,ops,ns_per_op,cache_misses".
+-------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "NodePool.h"
+
+using namespace std;
+
+static const int MAX_LIVE = 1 << 20;
+static const int ACQUIRE_MAX_LIVE = 1024; // acquire walks the free list
+
+typedef NodePool<int, MAX_LIVE> Pool;
+typedef Pool::Node Node;
+
+/***** PerfCounter *****/
+class PerfCounter
+{
+public:
+    PerfCounter() : fd(-1)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+    ~PerfCounter()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+    void start()
+    {
+        if (fd < 0)
+            return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    long long stop()
+    {
+        if (fd < 0)
+            return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+            return -1;
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+enum Pattern { LIFO, FIFO, RANDOM };
+static const char *patternName(Pattern p)
+{
+    return p == LIFO ? "lifo" : p == FIFO ? "fifo" : "random";
+}
+
+// Order in which the `live` allocations of a round are freed
+static vector<int> freeOrder(Pattern pattern, int live)
+{
+    vector<int> order(live);
+    iota(order.begin(), order.end(), 0);
+    if (pattern == LIFO)
+        reverse(order.begin(), order.end());
+    else if (pattern == RANDOM)
+        shuffle(order.begin(), order.end(), mt19937(7));
+    return order;
+}
+
+static PerfCounter counter;
+
+// Runs rounds of "allocate live, free live in order" until ops is reached
+template <typename Alloc, typename Free, typename EndRound>
+static void runCase(const char *impl, Pattern pattern, int live, long ops,
+                    Alloc alloc, Free release, EndRound endRound)
+{
+    vector<int> order = freeOrder(pattern, live);
+    vector<void *> slots(live);
+    long rounds = max(1L, ops / (2L * live));
+
+    counter.start();
+    auto start = chrono::steady_clock::now();
+    for (long r = 0; r < rounds; ++r)
+    {
+        for (int i = 0; i < live; ++i)
+            slots[i] = alloc(i);
+        for (int i = 0; i < live; ++i)
+            release(slots[order[i]]);
+        endRound();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long misses = counter.stop();
+
+    long done = rounds * 2L * live;
+    cout << impl << "," << patternName(pattern) << "," << live << "," << done << ","
+         << seconds * 1e9 / done << "," << misses << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    long opsPerCase = argc > 1 ? atol(argv[1]) : 8000000L;
+    static Pool pool;
+    const int liveSizes[] = {1024, 65536, MAX_LIVE};
+    const Pattern patterns[] = {LIFO, FIFO, RANDOM};
+
+    cout << "impl,pattern,live,ops,ns_per_op,cache_misses\n";
+    for (int live : liveSizes)
+    {
+        for (Pattern pattern : patterns)
+        {
+            // Pool handles are slot indices; carry them in the void* vector
+            runCase("NodePool", pattern, live, opsPerCase,
+                    [&](int) { return (void *)(intptr_t)pool.newNode(); },
+                    [&](void *p) { pool.deleteNode((int)(intptr_t)p); },
+                    [] {});
+
+            if (live <= ACQUIRE_MAX_LIVE)
+            {
+                // Acquire slots 0..live-1 by index: each call searches the
+                // free list, whose order the previous round's frees set
+                pool.reset();
+                runCase("NodePool_acquire", pattern, live, opsPerCase / 16,
+                        [&](int i) {
+                            pool.acquire(i);
+                            return (void *)(intptr_t)i;
+                        },
+                        [&](void *p) { pool.deleteNode((int)(intptr_t)p); },
+                        [] {});
+                pool.reset();
+            }
+
+            runCase("new_delete", pattern, live, opsPerCase,
+                    [](int) { return (void *)new Node(); },
+                    [](void *p) { delete static_cast<Node *>(p); },
+                    [] {});
+
+            pmr::unsynchronized_pool_resource poolResource;
+            runCase("pmr_pool", pattern, live, opsPerCase,
+                    [&](int) { return poolResource.allocate(sizeof(Node), alignof(Node)); },
+                    [&](void *p) { poolResource.deallocate(p, sizeof(Node), alignof(Node)); },
+                    [] {});
+
+            pmr::monotonic_buffer_resource monotonic;
+            runCase("pmr_monotonic", pattern, live, opsPerCase,
+                    [&](int) { return monotonic.allocate(sizeof(Node), alignof(Node)); },
+                    [&](void *p) { monotonic.deallocate(p, sizeof(Node), alignof(Node)); },
+                    [&] { monotonic.release(); });
+        }
+    }
+    return 0;
+}
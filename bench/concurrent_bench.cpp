@@ -0,0 +1,133 @@
+/*-- concurrent_bench.cpp --------------------------------------------------
+
+  Scaling benchmark for ConcurrentArrayLinkedList.
+
+  Runs the same random mix of insertSorted / removeValue / find calls on
+  1..maxThreads threads, once against ConcurrentArrayLinkedList (lazy
+  per-node locking) and once against ArrayLinkedList guarded by one global mutex.
+
+  Usage:
+    concurrent_bench [maxThreads] [opsPerThread]
+
+  Output: CSV lines "impl,threads,ops,seconds,mops_per_sec".
+-------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "NodePool.h"
+#include "List.h"
+#include "ConcurrentList.h"
+
+using namespace std;
+
+static const int NUM_NODES = 4096;
+static const int KEY_RANGE = 2048; // keeps the list about half full
+
+// find() results land here so the compiler cannot drop the walk
+static atomic<long> findSink(0);
+
+// One random operation: 20% insert, 20% remove, 60% find
+template <typename Insert, typename Remove, typename Find>
+static void runWorker(unsigned seed, int ops, Insert insertOp, Remove removeOp, Find findOp)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> keyDist(0, KEY_RANGE - 1);
+    uniform_int_distribution<int> opDist(0, 9);
+    for (int i = 0; i < ops; ++i)
+    {
+        int key = keyDist(rng);
+        int op = opDist(rng);
+        if (op < 2)
+            insertOp(key);
+        else if (op < 4)
+            removeOp(key);
+        else
+            findOp(key);
+    }
+}
+
+template <typename Body>
+static double timeThreads(int threads, Body body)
+{
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back(body, t);
+    for (thread &w : workers)
+        w.join();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *impl, int threads, long ops, double seconds)
+{
+    cout << impl << "," << threads << "," << ops << "," << seconds << ","
+         << (ops / seconds) / 1e6 << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)thread::hardware_concurrency();
+    int opsPerThread = argc > 2 ? atoi(argv[2]) : 20000;
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    cout << "impl,threads,ops,seconds,mops_per_sec\n";
+
+    for (int threads = 1; threads <= maxThreads; ++threads)
+    {
+        long totalOps = (long)threads * opsPerThread;
+
+        // Lazily synchronised list
+        static ConcurrentArrayLinkedList<int, NUM_NODES> clist;
+        for (int k = 0; k < KEY_RANGE; k += 2)
+            clist.insertSorted(k);
+        double seconds = timeThreads(threads, [&](int t) {
+            runWorker(1234u + t, opsPerThread,
+                      [&](int k) { clist.insertSorted(k); },
+                      [&](int k) { clist.removeValue(k); },
+                      [&](int k) { findSink.fetch_add(clist.find(k), memory_order_relaxed); });
+        });
+        report("concurrent", threads, totalOps, seconds);
+        for (int k = 0; k < KEY_RANGE; ++k)
+            while (clist.removeValue(k))
+                ;
+
+        // Plain list behind one global lock
+        static NodePool<int, NUM_NODES> pool;
+        ArrayLinkedList<int, NUM_NODES> list(pool);
+        mutex listLock;
+        int used = 0; // tracked here so the full-pool check stays O(1)
+        for (int k = 0; k < KEY_RANGE; k += 2, ++used)
+            list.insertSorted(k);
+        seconds = timeThreads(threads, [&](int t) {
+            runWorker(1234u + t, opsPerThread,
+                      [&](int k) {
+                          lock_guard<mutex> guard(listLock);
+                          if (used < NUM_NODES && list.insertSorted(k))
+                              ++used;
+                      },
+                      [&](int k) {
+                          lock_guard<mutex> guard(listLock);
+                          if (list.removeValue(k))
+                              --used;
+                      },
+                      [&](int k) {
+                          int found;
+                          {
+                              lock_guard<mutex> guard(listLock);
+                              found = list.find(k);
+                          }
+                          findSink.fetch_add(found, memory_order_relaxed);
+                      });
+        });
+        report("global_lock", threads, totalOps, seconds);
+    }
+
+    return 0;
+}
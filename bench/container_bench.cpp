@@ -0,0 +1,537 @@
+/*-- container_bench.cpp ---------------------------------------------------
+
+  Regression benchmark for ArrayLinkedList against std::list,
+  std::forward_list and std::vector doing the same work.
+
+  For every size and for int and std::string payloads, each public list
+  operation is timed per container:
+     insertFront, insertBack, insertSorted   n inserts into an empty list
+     insertAt                                n inserts into an empty list
+                                             at a chosen pool slot (std:
+                                             push_back, there are no slots)
+     insertAfter, insertBefore               n inserts next to random keys
+     insertAtPosition                        n inserts at random positions
+     find, getAt, size                       n lookups / calls
+     removeValue                             remove n keys (first match)
+     removeAllOccurrences                    remove every match of n keys
+     removeAfter, removeBefore               remove the neighbour of n keys
+     removeSlot                              remove every node by pool slot
+                                             in random order (std::list:
+                                             by iterator; std::vector: at
+                                             a random position, elements
+                                             have no stable identity)
+     deleteFront, deleteBack                 empty an n-element list
+     sortAscending, sortDescending, reverse  whole list
+     removeDuplicates                        keep first occurrences
+     copy, operator+                         copy a list / concatenate two
+
+  Keys are drawn from [0, n/2), so about half the values are duplicates.
+  Each operation runs once as a warm-up and then RUNS times, each run on
+  freshly prepared input (preparation is not timed); the median run is
+  reported.
+
+  Usage:
+    container_bench [maxSize]          (sizes 1000, 4x, 16x ... up to maxSize)
+
+  Output: CSV lines "impl,payload,op,n,seconds,ns_per_element".
+-------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <forward_list>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "NodePool.h"
+#include "List.h"
+
+using namespace std;
+
+static const int MAX_SIZE = 16384;
+static const int NUM_NODES = 4 * MAX_SIZE; // operator+ holds 4n nodes
+static const int RUNS = 5;                 // timed runs per operation
+
+template <typename T> T makeValue(int key);
+template <> int makeValue<int>(int key) { return key; }
+template <> string makeValue<string>(int key)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "payload-string-%08d", key); // beyond SSO
+    return text;
+}
+
+template <typename T> struct PayloadName;
+template <> struct PayloadName<int> { static const char *get() { return "int"; } };
+template <> struct PayloadName<string> { static const char *get() { return "string"; } };
+
+// Inputs shared by every container for one size
+template <typename T>
+struct BenchInput
+{
+    vector<T> values;      // n values to insert
+    vector<T> probes;      // n keys to look up / remove
+    vector<int> positions; // positions[i] in [0, n + i]
+    vector<int> order;     // a permutation of [0, n) for removeSlot
+};
+
+// Median of RUNS timed runs after one warm-up; setup is not timed
+template <typename Setup, typename Body>
+static double timeIt(Setup setup, Body body)
+{
+    vector<double> times;
+    for (int run = 0; run <= RUNS; ++run)
+    {
+        setup();
+        auto start = chrono::steady_clock::now();
+        body();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (run > 0)
+            times.push_back(seconds);
+    }
+    sort(times.begin(), times.end());
+    return times[RUNS / 2];
+}
+
+template <typename Body>
+static double timeIt(Body body)
+{
+    return timeIt([] {}, body);
+}
+
+static void report(const char *impl, const char *payload, const char *op, int n, double seconds)
+{
+    cout << impl << "," << payload << "," << op << "," << n << "," << seconds << ","
+         << seconds * 1e9 / n << "\n";
+}
+
+// Remove the first occurrence of value; false if absent
+template <typename Seq, typename T>
+static bool eraseFirst(Seq &seq, const T &value)
+{
+    auto it = find(seq.begin(), seq.end(), value);
+    if (it == seq.end())
+        return false;
+    seq.erase(it);
+    return true;
+}
+
+template <typename T>
+static bool eraseFirst(forward_list<T> &seq, const T &value)
+{
+    for (auto prev = seq.before_begin(), it = seq.begin(); it != seq.end(); prev = it++)
+    {
+        if (*it == value)
+        {
+            seq.erase_after(prev);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Seq, typename T>
+static void eraseAll(Seq &seq, const T &value)
+{
+    seq.erase(remove(seq.begin(), seq.end(), value), seq.end());
+}
+
+template <typename T>
+static void eraseAll(list<T> &seq, const T &value) { seq.remove(value); }
+
+template <typename T>
+static void eraseAll(forward_list<T> &seq, const T &value) { seq.remove(value); }
+
+// Iterator before the first match (before_begin() if it is the first),
+// or end() if value is absent
+template <typename T>
+static typename forward_list<T>::iterator findBefore(forward_list<T> &seq, const T &value)
+{
+    for (auto prev = seq.before_begin(), it = seq.begin(); it != seq.end(); prev = it++)
+    {
+        if (*it == value)
+            return prev;
+    }
+    return seq.end();
+}
+
+// Iterator at position pos (a linear walk except for std::vector)
+template <typename Seq>
+static typename Seq::iterator positionOf(Seq &seq, int pos)
+{
+    return next(seq.begin(), pos);
+}
+
+template <typename Seq>
+static void removeDuplicateValues(Seq &seq)
+{
+    unordered_set<typename Seq::value_type> seen;
+    seq.erase(remove_if(seq.begin(), seq.end(),
+                        [&](const typename Seq::value_type &v) { return !seen.insert(v).second; }),
+              seq.end());
+}
+
+template <typename T>
+static void removeDuplicateValues(list<T> &seq)
+{
+    unordered_set<T> seen;
+    seq.remove_if([&](const T &v) { return !seen.insert(v).second; });
+}
+
+template <typename T>
+static void removeDuplicateValues(forward_list<T> &seq)
+{
+    unordered_set<T> seen;
+    seq.remove_if([&](const T &v) { return !seen.insert(v).second; });
+}
+
+/***** ArrayLinkedList *****/
+template <typename T>
+static void benchArrayList(const BenchInput<T> &in)
+{
+    typedef ArrayLinkedList<T, NUM_NODES> List;
+    static NodePool<T, NUM_NODES> pool;
+    const char *impl = "ArrayLinkedList";
+    const char *payload = PayloadName<T>::get();
+    const vector<T> &values = in.values, &probes = in.probes;
+    int n = (int)values.size();
+
+    List l(pool), s(pool);
+    for (const T &v : values)
+        l.insertBack(v);
+    auto empty = [&] { s.clear(); };
+    auto copyOfL = [&] { s = l; };
+
+    report(impl, payload, "insertFront", n, timeIt(empty, [&] { for (const T &v : values) s.insertFront(v); }));
+    report(impl, payload, "insertBack", n, timeIt(empty, [&] { for (const T &v : values) s.insertBack(v); }));
+    report(impl, payload, "insertSorted", n, timeIt(empty, [&] { for (const T &v : values) s.insertSorted(v); }));
+    report(impl, payload, "insertAt", n, timeIt(empty, [&] {
+        for (const T &v : values)
+            s.insertAt(pool.nextFree(), v);
+    }));
+    report(impl, payload, "insertAfter", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+            s.insertAfter(probes[i], values[i]);
+    }));
+    report(impl, payload, "insertBefore", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+            s.insertBefore(probes[i], values[i]);
+    }));
+    report(impl, payload, "insertAtPosition", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+            s.insertAtPosition(in.positions[i], values[i]);
+    }));
+
+    long hits = 0;
+    report(impl, payload, "find", n, timeIt([&] { for (const T &v : probes) hits += l.find(v) >= 0; }));
+    report(impl, payload, "getAt", n, timeIt([&] {
+        for (int i = 0; i < n; ++i)
+            hits += l.getAt(in.positions[i] % n) == probes[0];
+    }));
+    report(impl, payload, "size", n, timeIt([&] { for (int i = 0; i < n; ++i) hits += l.size(); }));
+
+    report(impl, payload, "removeValue", n, timeIt(copyOfL, [&] { for (const T &v : probes) s.removeValue(v); }));
+    report(impl, payload, "removeAllOccurrences", n, timeIt(copyOfL, [&] {
+        for (const T &v : probes)
+            s.removeAllOccurrences(v);
+    }));
+    report(impl, payload, "removeAfter", n, timeIt(copyOfL, [&] { for (const T &v : probes) s.removeAfter(v); }));
+    report(impl, payload, "removeBefore", n, timeIt(copyOfL, [&] { for (const T &v : probes) s.removeBefore(v); }));
+    vector<int> slots(n);
+    report(impl, payload, "removeSlot", n, timeIt(
+        [&] {
+            s = l;
+            vector<int> inList;
+            for (int idx = s.getHead(); idx != NULL_INDEX; idx = pool.node(idx).next)
+                inList.push_back(idx);
+            for (int i = 0; i < n; ++i)
+                slots[i] = inList[in.order[i]];
+        },
+        [&] {
+            for (int slot : slots)
+                s.removeSlot(slot);
+        }));
+    report(impl, payload, "deleteFront", n, timeIt(copyOfL, [&] { while (s.deleteFront()) ; }));
+    report(impl, payload, "deleteBack", n, timeIt(copyOfL, [&] { while (s.deleteBack()) ; }));
+
+    report(impl, payload, "copy", n, timeIt([&] { List copy(l); hits += copy.isEmpty(); }));
+    report(impl, payload, "sortAscending", n, timeIt(copyOfL, [&] { s.sortAscending(); }));
+    report(impl, payload, "sortDescending", n, timeIt(copyOfL, [&] { s.sortDescending(); }));
+    report(impl, payload, "reverse", n, timeIt(copyOfL, [&] { s.reverse(); }));
+    report(impl, payload, "removeDuplicates", n, timeIt(copyOfL, [&] { s.removeDuplicates(); }));
+    report(impl, payload, "operator+", n, timeIt([&] { List sum = l + l; hits += sum.isEmpty(); }));
+    if (hits < 0)
+        cerr << hits;
+}
+
+/***** standard containers *****/
+template <typename T, typename Seq, typename PushFront, typename PushBack>
+static void benchStd(const char *impl, const BenchInput<T> &in, PushFront pushFront, PushBack pushBack)
+{
+    constexpr bool isForward = is_same<Seq, forward_list<T> >::value;
+    constexpr bool isVector = is_same<Seq, vector<T> >::value;
+    const char *payload = PayloadName<T>::get();
+    const vector<T> &values = in.values, &probes = in.probes;
+    int n = (int)values.size();
+
+    Seq l, s;
+    pushBack(l, values);
+    auto empty = [&] { s.clear(); };
+    auto copyOfL = [&] { s = l; };
+
+    report(impl, payload, "insertFront", n, timeIt(empty, [&] { for (const T &v : values) pushFront(s, v); }));
+    report(impl, payload, "insertBack", n, timeIt(empty, [&] { pushBack(s, values); }));
+    report(impl, payload, "insertSorted", n, timeIt(empty, [&] {
+        for (const T &v : values)
+        {
+            if constexpr (isForward)
+            {
+                auto prev = s.before_begin();
+                for (auto it = s.begin(); it != s.end() && *it < v; prev = it++)
+                    ;
+                s.insert_after(prev, v);
+            }
+            else if constexpr (isVector)
+                s.insert(lower_bound(s.begin(), s.end(), v), v);
+            else
+                s.insert(find_if(s.begin(), s.end(), [&](const T &x) { return !(x < v); }), v);
+        }
+    }));
+    report(impl, payload, "insertAt", n, timeIt(empty, [&] { pushBack(s, values); }));
+    report(impl, payload, "insertAfter", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+        {
+            auto it = find(s.begin(), s.end(), probes[i]);
+            if (it == s.end())
+                continue;
+            if constexpr (isForward)
+                s.insert_after(it, values[i]);
+            else
+                s.insert(next(it), values[i]);
+        }
+    }));
+    report(impl, payload, "insertBefore", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+        {
+            if constexpr (isForward)
+            {
+                auto prev = findBefore(s, probes[i]);
+                if (prev != s.end())
+                    s.insert_after(prev, values[i]);
+            }
+            else
+            {
+                auto it = find(s.begin(), s.end(), probes[i]);
+                if (it != s.end())
+                    s.insert(it, values[i]);
+            }
+        }
+    }));
+    report(impl, payload, "insertAtPosition", n, timeIt(copyOfL, [&] {
+        for (int i = 0; i < n; ++i)
+        {
+            int pos = in.positions[i];
+            if constexpr (isForward)
+                s.insert_after(pos == 0 ? s.before_begin() : positionOf(s, pos - 1), values[i]);
+            else
+                s.insert(positionOf(s, pos), values[i]);
+        }
+    }));
+
+    long hits = 0;
+    report(impl, payload, "find", n, timeIt([&] {
+        for (const T &v : probes)
+            hits += find(l.begin(), l.end(), v) != l.end();
+    }));
+    report(impl, payload, "getAt", n, timeIt([&] {
+        for (int i = 0; i < n; ++i)
+            hits += *positionOf(l, in.positions[i] % n) == probes[0];
+    }));
+    report(impl, payload, "size", n, timeIt([&] {
+        for (int i = 0; i < n; ++i)
+            hits += distance(l.begin(), l.end()); // O(1) for list and vector
+    }));
+
+    report(impl, payload, "removeValue", n, timeIt(copyOfL, [&] { for (const T &v : probes) eraseFirst(s, v); }));
+    report(impl, payload, "removeAllOccurrences", n, timeIt(copyOfL, [&] { for (const T &v : probes) eraseAll(s, v); }));
+    report(impl, payload, "removeAfter", n, timeIt(copyOfL, [&] {
+        for (const T &v : probes)
+        {
+            auto it = find(s.begin(), s.end(), v);
+            if (it == s.end() || next(it) == s.end())
+                continue;
+            if constexpr (isForward)
+                s.erase_after(it);
+            else
+                s.erase(next(it));
+        }
+    }));
+    report(impl, payload, "removeBefore", n, timeIt(copyOfL, [&] {
+        for (const T &v : probes)
+        {
+            if constexpr (isForward)
+            {
+                // Track the node two before the match
+                auto prevPrev = s.end(), prev = s.before_begin();
+                for (auto it = s.begin(); it != s.end(); prevPrev = prev, prev = it++)
+                {
+                    if (*it == v)
+                    {
+                        if (prevPrev != s.end())
+                            s.erase_after(prevPrev);
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                auto it = find(s.begin(), s.end(), v);
+                if (it != s.end() && it != s.begin())
+                    s.erase(prev(it));
+            }
+        }
+    }));
+    if constexpr (isVector)
+    {
+        report(impl, payload, "removeSlot", n, timeIt(copyOfL, [&] {
+            for (int i = 0; i < n; ++i)
+                s.erase(s.begin() + in.order[i] % (n - i));
+        }));
+    }
+    else
+    {
+        vector<typename Seq::iterator> nodes(n);
+        report(impl, payload, "removeSlot", n, timeIt(
+            [&] {
+                s = l;
+                vector<typename Seq::iterator> inList;
+                for (auto it = s.begin(); it != s.end(); ++it)
+                    inList.push_back(it);
+                for (int i = 0; i < n; ++i)
+                    nodes[i] = inList[in.order[i]];
+            },
+            [&] {
+                for (auto node : nodes)
+                {
+                    if constexpr (isForward)
+                    {
+                        auto prev = s.before_begin();
+                        while (next(prev) != node)
+                            ++prev;
+                        s.erase_after(prev);
+                    }
+                    else
+                        s.erase(node);
+                }
+            }));
+    }
+    report(impl, payload, "deleteFront", n, timeIt(copyOfL, [&] {
+        while (!s.empty())
+        {
+            if constexpr (isVector)
+                s.erase(s.begin());
+            else
+                s.pop_front();
+        }
+    }));
+    report(impl, payload, "deleteBack", n, timeIt(copyOfL, [&] {
+        while (!s.empty())
+        {
+            if constexpr (isForward)
+            {
+                auto prev = s.before_begin();
+                while (next(prev, 2) != s.end())
+                    ++prev;
+                s.erase_after(prev);
+            }
+            else
+                s.pop_back();
+        }
+    }));
+
+    report(impl, payload, "copy", n, timeIt([&] { Seq copy(l); hits += copy.empty(); }));
+    if constexpr (isVector)
+    {
+        report(impl, payload, "sortAscending", n, timeIt(copyOfL, [&] { sort(s.begin(), s.end()); }));
+        report(impl, payload, "sortDescending", n, timeIt(copyOfL, [&] { sort(s.begin(), s.end(), greater<T>()); }));
+        report(impl, payload, "reverse", n, timeIt(copyOfL, [&] { reverse(s.begin(), s.end()); }));
+    }
+    else
+    {
+        report(impl, payload, "sortAscending", n, timeIt(copyOfL, [&] { s.sort(); }));
+        report(impl, payload, "sortDescending", n, timeIt(copyOfL, [&] { s.sort(greater<T>()); }));
+        report(impl, payload, "reverse", n, timeIt(copyOfL, [&] { s.reverse(); }));
+    }
+    report(impl, payload, "removeDuplicates", n, timeIt(copyOfL, [&] { removeDuplicateValues(s); }));
+    report(impl, payload, "operator+", n, timeIt([&] {
+        Seq sum(l);
+        if constexpr (isForward)
+        {
+            auto tail = sum.before_begin();
+            for (auto it = sum.begin(); it != sum.end(); ++it)
+                tail = it;
+            sum.insert_after(tail, l.begin(), l.end());
+        }
+        else
+            sum.insert(sum.end(), l.begin(), l.end());
+        hits += sum.empty();
+    }));
+    if (hits < 0)
+        cerr << hits;
+}
+
+template <typename T>
+static void runSize(int n)
+{
+    mt19937 rng(42u + n);
+    uniform_int_distribution<int> keyDist(0, max(1, n / 2) - 1);
+    BenchInput<T> in;
+    for (int i = 0; i < n; ++i)
+    {
+        in.values.push_back(makeValue<T>(keyDist(rng)));
+        in.probes.push_back(makeValue<T>(keyDist(rng)));
+        in.positions.push_back((int)(rng() % (unsigned)(n + i + 1)));
+    }
+    in.order.resize(n);
+    iota(in.order.begin(), in.order.end(), 0);
+    shuffle(in.order.begin(), in.order.end(), rng);
+
+    benchArrayList<T>(in);
+    benchStd<T, list<T> >("std::list", in,
+                          [](list<T> &s, const T &v) { s.push_front(v); },
+                          [](list<T> &s, const vector<T> &vs) { for (const T &v : vs) s.push_back(v); });
+    benchStd<T, forward_list<T> >("std::forward_list", in,
+                                  [](forward_list<T> &s, const T &v) { s.push_front(v); },
+                                  [](forward_list<T> &s, const vector<T> &vs) {
+                                      auto tail = s.before_begin();
+                                      while (next(tail) != s.end())
+                                          ++tail;
+                                      for (const T &v : vs)
+                                          tail = s.insert_after(tail, v);
+                                  });
+    benchStd<T, vector<T> >("std::vector", in,
+                            [](vector<T> &s, const T &v) { s.insert(s.begin(), v); },
+                            [](vector<T> &s, const vector<T> &vs) { for (const T &v : vs) s.push_back(v); });
+}
+
+int main(int argc, char *argv[])
+{
+    int maxSize = argc > 1 ? atoi(argv[1]) : MAX_SIZE;
+    if (maxSize > MAX_SIZE)
+        maxSize = MAX_SIZE; // the pools are sized for MAX_SIZE
+
+    cout << "impl,payload,op,n,seconds,ns_per_element\n";
+    for (int n = 1000; n <= maxSize; n *= 4)
+    {
+        runSize<int>(n);
+        runSize<string>(n);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*-- shm_bench.cpp ---------------------------------------------------------
+
+  Multi-process benchmark for SharedNodePool.
+
+  P producer processes (fork) each send opsPerProcess ints to the parent:
+     pipe:        write(2) of one int per message into a pipe, parent reads
+     pipe_batch:  same, but 256 ints per write/read
+     shm_list:    insertBack into a list in a shared NodePool, parent
+                  pops with popFront (FIFO, as the pipe is); one lock
+                  round-trip per element
+
+  Usage:
+    shm_bench [maxProcesses] [opsPerProcess]
+
+  Output: CSV lines "impl,processes,ops,seconds,mops_per_sec".
+-------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "SharedPool.h"
+
+using namespace std;
+
+static const int NUM_NODES = 1 << 16;
+static const int PIPE_BATCH = 256;
+static const char *SEGMENT = "/shm_bench_pool";
+
+static void report(const char *impl, int processes, long ops, double seconds)
+{
+    cout << impl << "," << processes << "," << ops << "," << seconds << ","
+         << (ops / seconds) / 1e6 << "\n";
+}
+
+template <typename Child>
+static void forkChildren(int processes, Child child)
+{
+    for (int p = 0; p < processes; ++p)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            child(p);
+            _exit(0);
+        }
+        if (pid < 0)
+        {
+            cerr << "fork failed\n";
+            exit(1);
+        }
+    }
+}
+
+static void waitChildren(int processes)
+{
+    for (int p = 0; p < processes; ++p)
+        wait(0);
+}
+
+static bool readAll(int fd, char *buf, size_t bytes)
+{
+    while (bytes > 0)
+    {
+        ssize_t n = read(fd, buf, bytes);
+        if (n <= 0)
+            return false;
+        buf += n;
+        bytes -= (size_t)n;
+    }
+    return true;
+}
+
+static double runPipe(int processes, int opsPerProcess, int batch)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        exit(1);
+    auto start = chrono::steady_clock::now();
+    forkChildren(processes, [&](int p) {
+        close(fds[0]);
+        vector<int> buf(batch);
+        for (int i = 0; i < opsPerProcess; i += batch)
+        {
+            int n = min(batch, opsPerProcess - i);
+            for (int k = 0; k < n; ++k)
+                buf[k] = p * opsPerProcess + i + k;
+            if (write(fds[1], buf.data(), n * sizeof(int)) < 0)
+                _exit(1);
+        }
+    });
+    close(fds[1]);
+
+    long expected = (long)processes * opsPerProcess;
+    long received = 0, checksum = 0;
+    vector<int> buf(batch);
+    while (received < expected)
+    {
+        long n = min<long>(batch, expected - received);
+        if (!readAll(fds[0], (char *)buf.data(), n * sizeof(int)))
+            break;
+        for (long k = 0; k < n; ++k)
+            checksum += buf[k];
+        received += n;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    close(fds[0]);
+    waitChildren(processes);
+    if (received != expected || checksum != expected * (expected - 1) / 2)
+        cerr << "pipe: lost messages\n";
+    return seconds;
+}
+
+static double runShared(int processes, int opsPerProcess)
+{
+    SharedNodePool<int, NUM_NODES>::unlink(SEGMENT);
+    SharedNodePool<int, NUM_NODES> shared(SEGMENT);
+    SharedList<int, NUM_NODES> queue = shared.list("queue");
+
+    auto start = chrono::steady_clock::now();
+    forkChildren(processes, [&](int p) {
+        // Reopen by name, as an unrelated process would
+        SharedNodePool<int, NUM_NODES> child(SEGMENT);
+        SharedList<int, NUM_NODES> q = child.list("queue");
+        for (int i = 0; i < opsPerProcess; ++i)
+        {
+            while (!q.insertBack(p * opsPerProcess + i))
+                sched_yield(); // pool full: wait for the consumer
+        }
+    });
+
+    long expected = (long)processes * opsPerProcess;
+    long received = 0, checksum = 0;
+    int value;
+    while (received < expected)
+    {
+        if (queue.popFront(value))
+        {
+            checksum += value;
+            ++received;
+        }
+        else
+            sched_yield();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    waitChildren(processes);
+    SharedNodePool<int, NUM_NODES>::unlink(SEGMENT);
+    if (checksum != expected * (expected - 1) / 2)
+        cerr << "shm_list: lost messages\n";
+    return seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    int maxProcesses = argc > 1 ? atoi(argv[1]) : 4;
+    int opsPerProcess = argc > 2 ? atoi(argv[2]) : 200000;
+    if (maxProcesses < 1)
+        maxProcesses = 1;
+
+    cout << "impl,processes,ops,seconds,mops_per_sec\n";
+    cout.flush(); // children must not inherit buffered output
+
+    for (int processes = 1; processes <= maxProcesses; ++processes)
+    {
+        long totalOps = (long)processes * opsPerProcess;
+        report("pipe", processes, totalOps, runPipe(processes, opsPerProcess, 1));
+        cout.flush();
+        report("pipe_batch", processes, totalOps, runPipe(processes, opsPerProcess, PIPE_BATCH));
+        cout.flush();
+        report("shm_list", processes, totalOps, runShared(processes, opsPerProcess));
+        cout.flush();
+    }
+
+    return 0;
+}
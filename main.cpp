@@ -14,25 +14,148 @@
     • Menu options 17–24: other operations (display, find, reverse, size, etc.).
     • Menu option   25: exit the program.
 
+  Non-interactive modes (see Workload.h for the script format):
+    main --script FILE [--large]   run a command script, print results
+    main --record FILE             interactive; executed operations are
+                                   appended to FILE as a trace
+    main --replay FILE [--large]   run a script/trace at full speed with
+                                   output discarded; report throughput
+                                   and per-operation latency
+  --large uses a 65536-node pool instead of 5. In script and replay mode a
+  full pool refuses inserts instead of prompting. Deletions chosen at the
+  interactive full-pool prompt are not recorded.
+
   Precondition:  None (NodePool and lists initialize to empty state).
   Postcondition: All allocations and deallocations occur within the fixed
                  pool; program exits cleanly when user selects “25. Exit”.
 
 -------------------------------------------------------------------------*/
 
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "NodePool.h"
 #include "List.h"
+#include "Workload.h"
 
 using namespace std;
 
-int main()
+static const int MENU_NODES = 5;
+static const int LARGE_NODES = 65536;
+
+// Prompt for the arguments of a menu choice; false if nothing should run
+template <int N>
+static bool readMenuOp(NodePool<string, N> &pool, ArrayLinkedList<string, N> &list, WorkloadOp &op)
+{
+    switch (op.code)
+    {
+    case 1:
+    case 2:
+        cout << "Value: ";
+        getline(cin, op.value);
+        return true;
+    case 3:
+    case 4:
+        cout << "Key: ";
+        if (list.isEmpty())
+        {
+            cout << "List is empty" << endl;
+            return false;
+        }
+        cout << "the keys are :" << list << endl;
+        cout << (op.code == 3 ? "Value to insert after: " : "Value to insert before: ");
+        getline(cin, op.key);
+        cout << "New Value: ";
+        getline(cin, op.value);
+        return true;
+    case 5:
+        cout << "value to insert in ascending order: ";
+        getline(cin, op.value);
+        return true;
+    case 6:
+        cout << "value to insert in descending order: ";
+        getline(cin, op.value);
+        return true;
+    case 7:
+    case 8:
+        if (pool.freeCount() == 0)
+        {
+            cout << "No free slots available. \n"
+                 << endl;
+        }
+        else if (op.code == 7)
+        {
+            cout << "choose a position  between 0 and " << pool.usedCount()  << endl;
+        }
+        else
+        {
+            cout << "Free slots: ";
+            pool.displayFree(cout);
+            cout << endl;
+        }
+        cout << "Position: ";
+        cin >> op.pos;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Value: ";
+        getline(cin, op.value);
+        return true;
+    case 9:
+        if (list.isEmpty())
+        {
+            cout << "List is empty" << endl;
+            return false;
+        }
+        cout << "values: " << list << endl;
+        cout << "Value to delete: ";
+        getline(cin, op.value);
+        return true;
+    case 10:
+        if (pool.usedCount() == 0)
+        {
+            cout << "No used slots available. \n"
+                 << endl;
+            return false;
+        }
+        cout << "Used slots: \n";
+        pool.displayUsed(cout);
+        cout << endl
+             << "Position: ";
+        cin >> op.pos;
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return true;
+    case 12:
+        cout << "values: " << list << endl;
+        cout << "Value to remove all occurrences: ";
+        getline(cin, op.value);
+        return true;
+    case 13:
+    case 14:
+        cout << "values: " << list << endl;
+        cout << (op.code == 13 ? "Value to remove after: " : "Value to remove before: ");
+        getline(cin, op.key);
+        return true;
+    case 18:
+        cout << "Value: ";
+        getline(cin, op.value);
+        return true;
+    case 22:
+        cout << "Enter value to append to second list: ";
+        getline(cin, op.value);
+        return true;
+    default:
+        return true; // no arguments
+    }
+}
+
+static int runMenu(ostream *trace)
 {
-    NodePool<string, 5> pool;
-    ArrayLinkedList<string, 5> list(pool);
-    ArrayLinkedList<string, 5> list2(pool);
+    NodePool<string, MENU_NODES> pool;
+    ArrayLinkedList<string, MENU_NODES> list(pool);
+    ArrayLinkedList<string, MENU_NODES> list2(pool);
 
     while (true)
     {
@@ -78,227 +201,118 @@ int main()
             break;
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-        string value, key;
-        int pos;
-        bool result;
-
-        switch (choice)
-        {
-        case 1:
-            cout << "Value: ";
-            getline(cin, value);
-            list.insertFront(value);
-            break;
-        case 2:
-            cout << "Value: ";
-            getline(cin, value);
-            list.insertBack(value);
-            break;
-        case 3:
-            cout << "Key: ";
-            if (list.isEmpty())
-            {
-                cout << "List is empty" << endl;
-                break;
-            }
-            cout << "the keys are :" << list << endl;
-            cout << "Value to insert after: ";
-            getline(cin, key);
-            cout << "New Value: ";
-            getline(cin, value);
-            result = list.insertAfter(key, value);
-            cout << (result ? "Inserted" : "Key not found") << endl;
-            break;
-        case 4:
-            cout << "Key: ";
-            if (list.isEmpty())
-            {
-                cout << "List is empty" << endl;
-                break;
-            }
-            cout << "the keys are :" << list << endl;
-            cout << "Value to insert before: ";
-            getline(cin, key);
-            cout << "New Value: ";
-            getline(cin, value);
-            result = list.insertBefore(key, value);
-            cout << (result ? "Inserted" : "Key not found") << endl;
-            break;
-        case 5:
-            cout << "value to insert in ascending order: ";
-            getline(cin, value);
-            list.insertSorted(value);
-            cout << "List after insertion: " << list;
-            break;
-        case 6:
-            cout << "value to insert in descending order: ";
-            getline(cin, value);
-            list.insertSorted(value);
-            cout << "List after insertion: " << list;
-            break;
-        case 7:
-            if (pool.freeCount() == 0)
-            {
-                cout << "No free slots available. \n"
-                     << endl;
-            }
-            else
-            {
-                cout << "choose a position  between 0 and " << pool.usedCount()  << endl;
-               
-            };
-
-            cout << "Position: ";
-            cin >> pos;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Value: ";
-            getline(cin, value);
-            result = list.insertAtPosition(pos, value);
-            cout << (result ? "Inserted" : "Invalid position") << endl;
-            break;
-        case 8:
-            if (pool.freeCount() == 0)
-            {
-                cout << "No free slots available. \n"
-                     << endl;
-            }
-            else
-            {
-                cout << "Free slots: ";
-                pool.displayFree(cout);
-                cout << endl;
-            };
-            cout << "Position: ";
-            cin >> pos;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Value: ";
-            getline(cin, value);
-            result = list.insertAt(pos, value);
-            cout << (result ? "Inserted" : "Invalid position") << endl;
-            break;
-        case 9:
-            if (list.isEmpty())
-            {
-                cout << "List is empty" << endl;
-                break;
-            }
-            cout << "values: " << list << endl;
-            cout << "Value to delete: ";
-            getline(cin, value);
-            result = list.removeValue(value);
-            cout << (result ? "Removed" : "Value not found") << endl;
-            break;
-        case 10:
-            if (pool.usedCount() == 0)
-            {
-                cout << "No used slots available. \n"
-                     << endl;
-                break;
-            }
-            cout << "Used slots: \n";
-            pool.displayUsed(cout);
-            cout << endl
-                 << "Position: ";
-            cin >> pos;
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            result = list.removeSlot(pos);
-            cout << (result ? "Removed" : "Invalid position") << endl;
-            break;
-        case 11:
-            list.removeDuplicates();
-            cout << "Duplicates removed: " << list;
-            break;
-        case 12:
-            cout << "values: " << list << endl;
-            cout << "Value to remove all occurrences: ";
-            getline(cin, value);
-            result = list.removeAllOccurrences(value);
-            cout << (result ? "Removed all occurrences" : "Value not found") << endl;
-            break;
-        case 13:
-            cout << "values: " << list << endl;
-            cout << "Value to remove after: ";
-            getline(cin, key);
-            result = list.removeAfter(key);
-            cout << (result ? "Removed" : "Deletion failed.") << endl;
-            break;
-        case 14:
-            cout << "values: " << list << endl;
-            cout << "Value to remove before: ";
-            getline(cin, key);
-            result = list.removeBefore(key);
-            cout << (result ? "Removed" : "Deletion failed.") << endl;
-            break;
-        case 15:
-            list.sortAscending();
-            cout << "List in ascending order: " << list << endl;
-            break;
-        case 16:
-            list.sortDescending();
-            cout << "List in descending order: " << list << endl;
-            break;
-        case 17:
-            cout << list;
-            break;
-        case 18:
-            cout << "Value: ";
-            getline(cin, value);
-            pos = list.find(value);
-            if (pos >= 0)
-                cout << "Found at position " << pos << endl;
-            else
-                cout << "Not found" << endl;
-            break;
-        case 19:
-            list.reverse();
-            cout << "List reversed" << endl;
-            break;
-        case 20:
-            cout << "Size: " << list.size() << endl;
-            break;
-        case 21:
-            list.clear();
-            cout << "List cleared" << endl;
-            break;
-        case 22:
-            cout << "Enter value to append to second list: ";
-            getline(cin, value);
-            list2.insertBack(value);
-            cout << "Second list now: " << list2;
-            break;
-        case 23:
-            list += list2;
-            cout << "After concatenation: " << list;
-            break;
-        case 24:
-            if (pool.freeCount() == 0)
-            {
-                cout << "No free slots available. \n"
-                     << endl
-                     << "Used slots: ";
-                pool.displayUsed(cout);
-                break;
-            }
-            if (pool.usedCount() == 0)
-            {
-                cout << "No used slots available. \n"
-                     << endl
-                     << "Free slots: ";
-                pool.displayFree(cout);
-                break;
-            }
-            cout << "Free slots: \n";
-            pool.displayFree(cout);
-            cout << endl
-                 << "Used slots: ";
-            pool.displayUsed(cout);
-            break;
-        case 25:
+        if (choice == 25)
             return 0;
-        default:
+        if (choice < 1 || choice > WORKLOAD_OPS)
+        {
             cout << "Invalid option" << endl;
+            continue;
         }
+
+        WorkloadOp op;
+        op.code = choice;
+        if (!readMenuOp(pool, list, op))
+            continue;
+        if (trace)
+            *trace << formatWorkloadLine(op) << endl;
+        applyWorkloadOp(pool, list, list2, op, cout, false);
     }
 
     return 0;
 }
+
+// Script mode prints every result; replay mode times the operations
+template <int N>
+static int runScript(const char *path, bool replay)
+{
+    ifstream in(path);
+    if (!in)
+    {
+        cerr << "Cannot open " << path << endl;
+        return 1;
+    }
+
+    // Parse first so replay timing covers only the operations
+    vector<WorkloadOp> ops;
+    string line;
+    for (int lineNo = 1; getline(in, line); ++lineNo)
+    {
+        WorkloadOp op;
+        try
+        {
+            if (parseWorkloadLine(line, op))
+                ops.push_back(op);
+        }
+        catch (const invalid_argument &e)
+        {
+            cerr << path << ":" << lineNo << ": " << e.what() << endl;
+            return 1;
+        }
+    }
+
+    static NodePool<string, N> pool;
+    ArrayLinkedList<string, N> list(pool);
+    ArrayLinkedList<string, N> list2(pool);
+
+    if (!replay)
+    {
+        for (size_t i = 0; i < ops.size(); ++i)
+            applyWorkloadOp(pool, list, list2, ops[i], cout, true);
+        return 0;
+    }
+
+    ofstream discard; // never opened: output is dropped
+    WorkloadStats stats;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < ops.size(); ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        applyWorkloadOp(pool, list, list2, ops[i], discard, true);
+        auto t1 = chrono::steady_clock::now();
+        stats.add(ops[i].code, chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count());
+    }
+    stats.report(cout, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *script = 0, *record = 0, *replay = 0;
+    bool large = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--large") == 0)
+            large = true;
+        else if (i + 1 < argc && strcmp(argv[i], "--script") == 0)
+            script = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--record") == 0)
+            record = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--replay") == 0)
+            replay = argv[++i];
+        else
+        {
+            cerr << "usage: " << argv[0]
+                 << " [--script FILE | --record FILE | --replay FILE] [--large]" << endl;
+            return 2;
+        }
+    }
+
+    if (script || replay)
+    {
+        const char *path = script ? script : replay;
+        return large ? runScript<LARGE_NODES>(path, replay != 0)
+                     : runScript<MENU_NODES>(path, replay != 0);
+    }
+
+    if (record)
+    {
+        ofstream trace(record, ios::app);
+        if (!trace)
+        {
+            cerr << "Cannot open " << record << endl;
+            return 1;
+        }
+        return runMenu(&trace);
+    }
+    return runMenu(0);
+}